@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief 要素番号 0..n-1 にキーを持たせる d-ary heap (decrease-key 付き)
+ * @tparam Key key type
+ * @tparam D arity
+ */
+template <typename Key, std::size_t D = 4>
+class DaryHeap
+{
+public:
+    static_assert(D >= 2, "DaryHeap requires D >= 2");
+
+    explicit DaryHeap(const std::size_t n = 0)
+    {
+        reset(n);
+    }
+
+    // 要素数を n にして空にする
+    void reset(const std::size_t n)
+    {
+        heap_.clear();
+        key_.resize(n);
+        position_.assign(n, None());
+    }
+
+    /**
+     * @brief id を key で挿入する。既に入っていて key の方が小さければキーを減らす
+     */
+    void push(const std::size_t id, const Key& key)
+    {
+        if (contains(id))
+        {
+            if (key < key_[id])
+            {
+                key_[id] = key;
+                sift_up(position_[id]);
+            }
+            return;
+        }
+        key_[id] = key;
+        position_[id] = heap_.size();
+        heap_.push_back(id);
+        sift_up(heap_.size() - 1);
+    }
+
+    /**
+     * @brief 最小のキーを持つ要素番号を取り出す
+     */
+    std::size_t pop()
+    {
+        assert(!empty());
+        const std::size_t ret = heap_[0];
+        position_[ret] = None();
+        const std::size_t last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty())
+        {
+            heap_[0] = last;
+            position_[last] = 0;
+            sift_down(0);
+        }
+        return ret;
+    }
+
+    std::size_t top() const noexcept
+    {
+        return heap_[0];
+    }
+
+    const Key& key(const std::size_t id) const noexcept
+    {
+        return key_[id];
+    }
+
+    bool contains(const std::size_t id) const noexcept
+    {
+        return position_[id] != None();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return heap_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+private:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    void sift_up(std::size_t pos)
+    {
+        const std::size_t id = heap_[pos];
+        while (pos > 0)
+        {
+            const std::size_t parent = (pos - 1) / D;
+            if (!(key_[id] < key_[heap_[parent]]))
+            {
+                break;
+            }
+            heap_[pos] = heap_[parent];
+            position_[heap_[pos]] = pos;
+            pos = parent;
+        }
+        heap_[pos] = id;
+        position_[id] = pos;
+    }
+
+    void sift_down(std::size_t pos)
+    {
+        const std::size_t id = heap_[pos];
+        while (true)
+        {
+            const std::size_t first = pos * D + 1;
+            if (first >= heap_.size())
+            {
+                break;
+            }
+            const std::size_t last = std::min(first + D, heap_.size());
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; c++)
+            {
+                if (key_[heap_[c]] < key_[heap_[best]])
+                {
+                    best = c;
+                }
+            }
+            if (!(key_[heap_[best]] < key_[id]))
+            {
+                break;
+            }
+            heap_[pos] = heap_[best];
+            position_[heap_[pos]] = pos;
+            pos = best;
+        }
+        heap_[pos] = id;
+        position_[id] = pos;
+    }
+
+    std::vector<std::size_t> heap_;
+    std::vector<Key> key_;
+    std::vector<std::size_t> position_;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 要素番号 0..n-1 にキーを持たせる pairing heap (decrease-key 付き)
+ * 木は left-child right-sibling で持ち、prev は親 (先頭の子の場合) か左の兄弟を指す。
+ * @tparam Key key type
+ */
+template <typename Key>
+class PairingHeap
+{
+public:
+    explicit PairingHeap(const std::size_t n = 0)
+    {
+        reset(n);
+    }
+
+    // 要素数を n にして空にする
+    void reset(const std::size_t n)
+    {
+        key_.resize(n);
+        child_.assign(n, None());
+        next_.assign(n, None());
+        prev_.assign(n, None());
+        in_heap_.assign(n, false);
+        root_ = None();
+        size_ = 0;
+    }
+
+    /**
+     * @brief id を key で挿入する。既に入っていて key の方が小さければキーを減らす
+     */
+    void push(const std::size_t id, const Key& key)
+    {
+        if (in_heap_[id])
+        {
+            if (key < key_[id])
+            {
+                key_[id] = key;
+                if (id != root_)
+                {
+                    detach(id);
+                    root_ = meld(root_, id);
+                }
+            }
+            return;
+        }
+        key_[id] = key;
+        child_[id] = next_[id] = prev_[id] = None();
+        in_heap_[id] = true;
+        size_++;
+        root_ = meld(root_, id);
+    }
+
+    /**
+     * @brief 最小のキーを持つ要素番号を取り出す
+     */
+    std::size_t pop()
+    {
+        assert(!empty());
+        const std::size_t ret = root_;
+        in_heap_[ret] = false;
+        size_--;
+        root_ = merge_pairs(child_[ret]);
+        child_[ret] = None();
+        return ret;
+    }
+
+    std::size_t top() const noexcept
+    {
+        return root_;
+    }
+
+    const Key& key(const std::size_t id) const noexcept
+    {
+        return key_[id];
+    }
+
+    bool contains(const std::size_t id) const noexcept
+    {
+        return in_heap_[id];
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+private:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    // 根同士をつなぎ、新しい根を返す
+    std::size_t meld(std::size_t a, std::size_t b)
+    {
+        if (a == None())
+        {
+            return b;
+        }
+        if (b == None())
+        {
+            return a;
+        }
+        if (key_[b] < key_[a])
+        {
+            std::swap(a, b);
+        }
+        next_[b] = child_[a];
+        if (child_[a] != None())
+        {
+            prev_[child_[a]] = b;
+        }
+        prev_[b] = a;
+        child_[a] = b;
+        prev_[a] = next_[a] = None();
+        return a;
+    }
+
+    // 部分木 x を親から切り離す
+    void detach(const std::size_t x)
+    {
+        const std::size_t p = prev_[x];
+        if (child_[p] == x)
+        {
+            child_[p] = next_[x];
+        }
+        else
+        {
+            next_[p] = next_[x];
+        }
+        if (next_[x] != None())
+        {
+            prev_[next_[x]] = p;
+        }
+        next_[x] = prev_[x] = None();
+    }
+
+    // 兄弟リストを 2 pass でまとめる
+    std::size_t merge_pairs(std::size_t first)
+    {
+        buffer_.clear();
+        while (first != None())
+        {
+            const std::size_t a = first;
+            const std::size_t b = next_[a];
+            first = b == None() ? None() : next_[b];
+            next_[a] = prev_[a] = None();
+            if (b != None())
+            {
+                next_[b] = prev_[b] = None();
+            }
+            buffer_.push_back(meld(a, b));
+        }
+        if (buffer_.empty())
+        {
+            return None();
+        }
+        std::size_t ret = buffer_.back();
+        for (std::size_t i = buffer_.size() - 1; i-- > 0;)
+        {
+            ret = meld(buffer_[i], ret);
+        }
+        return ret;
+    }
+
+    std::vector<Key> key_;
+    std::vector<std::size_t> child_;
+    std::vector<std::size_t> next_;
+    std::vector<std::size_t> prev_;
+    std::vector<bool> in_heap_;
+    std::vector<std::size_t> buffer_;
+    std::size_t root_ = None();
+    std::size_t size_ = 0;
+};
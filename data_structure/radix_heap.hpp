@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 取り出すキーが単調非減少な場合に使える radix heap
+ * キーは非負整数に限る。push するキーは直前に pop したキー以上でなければならない。
+ * @tparam Key integral key type
+ * @tparam Value value type
+ */
+template <typename Key, typename Value>
+class RadixHeap
+{
+public:
+    static_assert(std::is_integral<Key>::value, "RadixHeap requires integral keys");
+
+    using UnsignedKey = typename std::make_unsigned<Key>::type;
+
+    void push(const Key key, const Value& value)
+    {
+        const UnsignedKey k = static_cast<UnsignedKey>(key);
+        assert(last_ <= k);
+        buckets_[bucket(k ^ last_)].emplace_back(k, value);
+        size_++;
+    }
+
+    /**
+     * @brief 最小のキーを持つ要素を取り出す
+     */
+    std::pair<Key, Value> pop()
+    {
+        assert(size_ > 0);
+        if (buckets_[0].empty())
+        {
+            std::size_t i = 1;
+            while (buckets_[i].empty())
+            {
+                i++;
+            }
+            UnsignedKey new_last = std::numeric_limits<UnsignedKey>::max();
+            for (const auto& e : buckets_[i])
+            {
+                new_last = std::min(new_last, e.first);
+            }
+            for (const auto& e : buckets_[i])
+            {
+                buckets_[bucket(e.first ^ new_last)].push_back(e);
+            }
+            buckets_[i].clear();
+            last_ = new_last;
+        }
+
+        auto ret = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return std::make_pair(static_cast<Key>(ret.first), ret.second);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // バケツの確保済み領域は残したまま空にする
+    void clear() noexcept
+    {
+        for (auto& b : buckets_)
+        {
+            b.clear();
+        }
+        last_ = 0;
+        size_ = 0;
+    }
+
+private:
+    static constexpr std::size_t Bits = std::numeric_limits<UnsignedKey>::digits;
+
+    // 最上位ビットの位置 + 1 (x == 0 なら 0)
+    static std::size_t bucket(const UnsignedKey x) noexcept
+    {
+        return x == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(x));
+    }
+
+    std::array<std::vector<std::pair<UnsignedKey, Value>>, Bits + 1> buckets_;
+    UnsignedKey last_ = 0;
+    std::size_t size_ = 0;
+};
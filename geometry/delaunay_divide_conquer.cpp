@@ -0,0 +1,372 @@
+#include "geometry/delaunay_divide_conquer.hpp"
+#include "geometry/predicates.hpp"
+#include "thread/parallel_sort.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+DivideConquerDelaunay::DivideConquerDelaunay(const std::vector<Point2D>& position_list)
+{
+    Sort(position_list, nullptr);
+    if (sorted_.size() >= 2)
+    {
+        hull_edge_ = Build(0, sorted_.size(), nullptr).left;
+    }
+}
+
+DivideConquerDelaunay::DivideConquerDelaunay(const std::vector<Point2D>& position_list, ThreadPool& pool)
+{
+    Sort(position_list, &pool);
+    if (sorted_.size() >= 2)
+    {
+        // タスクの数がスレッド数の数倍になる程度まで分ける
+        parallel_cutoff_ = std::max<std::size_t>(sorted_.size() / (pool.concurrency() * 4), 1 << 12);
+        hull_edge_ = Build(0, sorted_.size(), &pool).left;
+    }
+}
+
+SparseGraph<int, int> DivideConquerDelaunay::GetGraph() const
+{
+    SparseGraph<int, int> graph;
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        graph.push_node(i);
+    }
+    for (std::size_t q = 0; q < EdgeCapacity(); q++)
+    {
+        if (IsAlive(q))
+        {
+            graph.connect(Org(4 * q), Dest(4 * q));
+        }
+    }
+    return graph;
+}
+
+TriangleMesh DivideConquerDelaunay::GetTriangleMesh() const
+{
+    // 主の有向辺 e の half-edge 番号は halfedge[e / 2]
+    std::vector<std::uint32_t> halfedge(2 * EdgeCapacity(), TriangleMesh::None());
+    std::vector<std::uint32_t> triangles;
+    std::vector<std::uint32_t> edges;
+    for (std::size_t q = 0; q < EdgeCapacity(); q++)
+    {
+        if (!IsAlive(q))
+        {
+            continue;
+        }
+        for (const std::size_t e : { 4 * q, 4 * q + 2 })
+        {
+            if (halfedge[e / 2] != TriangleMesh::None())
+            {
+                continue;
+            }
+            // 左の面が 3 辺で、反時計回りなら三角形 (時計回りは 3 点の凸包の外側)
+            const std::size_t e1 = Lnext(e);
+            const std::size_t e2 = Lnext(e1);
+            if (Lnext(e2) != e || Orient2D(sorted_[Origin(e)], sorted_[Origin(e1)], sorted_[Origin(e2)]) <= 0)
+            {
+                continue;
+            }
+            for (const std::size_t f : { e, e1, e2 })
+            {
+                halfedge[f / 2] = triangles.size();
+                triangles.push_back(Org(f));
+                edges.push_back(f);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> halfedges(triangles.size());
+    for (std::size_t h = 0; h < triangles.size(); h++)
+    {
+        halfedges[h] = halfedge[Sym(edges[h]) / 2];
+    }
+    return TriangleMesh(size(), std::move(triangles), std::move(halfedges));
+}
+
+/**
+ * @brief 点を (x, y) の辞書順に並べ、同じ座標の点を除いて sorted_ / index_ を作る
+ */
+void DivideConquerDelaunay::Sort(const std::vector<Point2D>& position_list, ThreadPool* pool)
+{
+    size_ = position_list.size();
+
+    std::vector<std::pair<Point2D, std::size_t>> order(size_);
+    for (std::size_t i = 0; i < size_; i++)
+    {
+        order[i] = std::make_pair(position_list[i], i);
+    }
+    const auto less = [](const std::pair<Point2D, std::size_t>& p, const std::pair<Point2D, std::size_t>& q) {
+        if (p.first.x() != q.first.x())
+        {
+            return p.first.x() < q.first.x();
+        }
+        if (p.first.y() != q.first.y())
+        {
+            return p.first.y() < q.first.y();
+        }
+        return p.second < q.second;
+    };
+    if (pool != nullptr)
+    {
+        parallel_sort(order.begin(), order.end(), *pool, less);
+    }
+    else
+    {
+        std::sort(order.begin(), order.end(), less);
+    }
+
+    sorted_.reserve(size_);
+    index_.reserve(size_);
+    for (const auto& element : order)
+    {
+        const Point2D& p = element.first;
+        if (!sorted_.empty() && sorted_.back().x() == p.x() && sorted_.back().y() == p.y())
+        {
+            continue;
+        }
+        sorted_.push_back(p);
+        index_.push_back(element.second);
+    }
+    assert(sorted_.size() < None() / 12);
+
+    const std::size_t quads = 3 * sorted_.size();
+    next_.resize(4 * quads);
+    origin_.assign(2 * quads, None());
+}
+
+DivideConquerDelaunay::HullPair DivideConquerDelaunay::Build(const std::uint32_t lo, const std::uint32_t hi, ThreadPool* pool)
+{
+    if (hi - lo <= 3)
+    {
+        return BuildLeaf(lo, hi);
+    }
+
+    const std::uint32_t mid = lo + (hi - lo) / 2;
+    if (pool != nullptr && hi - lo >= parallel_cutoff_)
+    {
+        HullPair left;
+        ThreadPool::TaskGroup group;
+        pool->run(group, [&] { left = Build(lo, mid, pool); });
+        const HullPair right = Build(mid, hi, pool);
+        pool->wait(group);
+        return Merge(left, right);
+    }
+    const HullPair left = Build(lo, mid, nullptr);
+    const HullPair right = Build(mid, hi, nullptr);
+    return Merge(left, right);
+}
+
+/**
+ * @brief 2 点または 3 点の三角形分割。区間の quad-edge を全て空きリストに入れてから確保する
+ */
+DivideConquerDelaunay::HullPair DivideConquerDelaunay::BuildLeaf(const std::uint32_t lo, const std::uint32_t hi)
+{
+    FreeList free;
+    for (std::uint32_t q = 3 * hi; q > 3 * lo; q--)
+    {
+        Push(free, q - 1);
+    }
+
+    const std::uint32_t a = MakeEdge(lo, lo + 1, free);
+    if (hi - lo == 2)
+    {
+        return HullPair { a, static_cast<std::uint32_t>(Sym(a)), free };
+    }
+
+    const std::uint32_t b = MakeEdge(lo + 1, lo + 2, free);
+    Splice(Sym(a), b);
+
+    const double orientation = Orient2D(sorted_[lo], sorted_[lo + 1], sorted_[lo + 2]);
+    if (orientation > 0)
+    {
+        Connect(b, a, free);
+        return HullPair { a, static_cast<std::uint32_t>(Sym(b)), free };
+    }
+    if (orientation < 0)
+    {
+        const std::uint32_t c = Connect(b, a, free);
+        return HullPair { static_cast<std::uint32_t>(Sym(c)), c, free };
+    }
+    // 一直線上
+    return HullPair { a, static_cast<std::uint32_t>(Sym(b)), free };
+}
+
+/**
+ * @brief 左右の三角形分割を、下の共通接線から上へ辺を張りながら併合する
+ */
+DivideConquerDelaunay::HullPair DivideConquerDelaunay::Merge(HullPair left, HullPair right)
+{
+    FreeList free = Concat(left.free, right.free);
+
+    std::size_t ldo = left.left;
+    std::size_t ldi = left.right;
+    std::size_t rdi = right.left;
+    std::size_t rdo = right.right;
+
+    // 下の共通接線
+    while (true)
+    {
+        if (LeftOf(Origin(rdi), ldi))
+        {
+            ldi = Lnext(ldi);
+        }
+        else if (RightOf(Origin(ldi), rdi))
+        {
+            rdi = Rprev(rdi);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    std::size_t basel = Connect(Sym(rdi), ldi, free);
+    if (Origin(ldi) == Origin(ldo))
+    {
+        ldo = Sym(basel);
+    }
+    if (Origin(rdi) == Origin(rdo))
+    {
+        rdo = basel;
+    }
+
+    const auto pos = [&](const std::uint32_t v) -> const Point2D& {
+        return sorted_[v];
+    };
+    // basel の上側にある辺
+    const auto valid = [&](const std::size_t e) {
+        return RightOf(Destination(e), basel);
+    };
+
+    while (true)
+    {
+        // basel の両端から出る候補のうち、外接円が次の候補を含むものを消していく
+        std::size_t lcand = Onext(Sym(basel));
+        if (valid(lcand))
+        {
+            while (InCircle(pos(Destination(basel)), pos(Origin(basel)), pos(Destination(lcand)), pos(Destination(Onext(lcand)))) > 0)
+            {
+                const std::size_t t = Onext(lcand);
+                DeleteEdge(lcand, free);
+                lcand = t;
+            }
+        }
+
+        std::size_t rcand = Oprev(basel);
+        if (valid(rcand))
+        {
+            while (InCircle(pos(Destination(basel)), pos(Origin(basel)), pos(Destination(rcand)), pos(Destination(Oprev(rcand)))) > 0)
+            {
+                const std::size_t t = Oprev(rcand);
+                DeleteEdge(rcand, free);
+                rcand = t;
+            }
+        }
+
+        const bool left_valid = valid(lcand);
+        const bool right_valid = valid(rcand);
+        if (!left_valid && !right_valid)
+        {
+            // 上の共通接線に着いた
+            break;
+        }
+
+        if (!left_valid || (right_valid && InCircle(pos(Destination(lcand)), pos(Origin(lcand)), pos(Origin(rcand)), pos(Destination(rcand))) > 0))
+        {
+            basel = Connect(rcand, Sym(basel), free);
+        }
+        else
+        {
+            basel = Connect(Sym(basel), Sym(lcand), free);
+        }
+    }
+
+    return HullPair { static_cast<std::uint32_t>(ldo), static_cast<std::uint32_t>(rdo), free };
+}
+
+std::uint32_t DivideConquerDelaunay::Pop(FreeList& free)
+{
+    const std::uint32_t q = free.head;
+    assert(q != None());
+    free.head = next_[4 * q];
+    if (free.head == None())
+    {
+        free.tail = None();
+    }
+    return q;
+}
+
+std::uint32_t DivideConquerDelaunay::MakeEdge(const std::uint32_t from, const std::uint32_t to, FreeList& free)
+{
+    const std::uint32_t q = Pop(free);
+    const std::uint32_t e = 4 * q;
+    next_[e] = e;
+    next_[e + 1] = e + 3;
+    next_[e + 2] = e + 2;
+    next_[e + 3] = e + 1;
+    origin_[2 * q] = from;
+    origin_[2 * q + 1] = to;
+    return e;
+}
+
+void DivideConquerDelaunay::Splice(const std::size_t a, const std::size_t b)
+{
+    const std::size_t alpha = Rot(next_[a]);
+    const std::size_t beta = Rot(next_[b]);
+    std::swap(next_[a], next_[b]);
+    std::swap(next_[alpha], next_[beta]);
+}
+
+// a の終点から b の始点へ辺を張る (a, 新しい辺, b が同じ左の面を囲む)
+std::uint32_t DivideConquerDelaunay::Connect(const std::size_t a, const std::size_t b, FreeList& free)
+{
+    const std::uint32_t e = MakeEdge(Destination(a), Origin(b), free);
+    Splice(e, Lnext(a));
+    Splice(Sym(e), b);
+    return e;
+}
+
+void DivideConquerDelaunay::DeleteEdge(const std::size_t e, FreeList& free)
+{
+    Splice(e, Oprev(e));
+    Splice(Sym(e), Oprev(Sym(e)));
+    Push(free, e / 4);
+}
+
+void DivideConquerDelaunay::Push(FreeList& free, const std::uint32_t q)
+{
+    origin_[2 * q] = None();
+    next_[4 * q] = free.head;
+    if (free.head == None())
+    {
+        free.tail = q;
+    }
+    free.head = q;
+}
+
+DivideConquerDelaunay::FreeList DivideConquerDelaunay::Concat(FreeList a, FreeList b)
+{
+    if (a.head == None())
+    {
+        return b;
+    }
+    if (b.head != None())
+    {
+        next_[4 * a.tail] = b.head;
+        a.tail = b.tail;
+    }
+    return a;
+}
+
+bool DivideConquerDelaunay::LeftOf(const std::uint32_t p, const std::size_t e) const noexcept
+{
+    return Orient2D(sorted_[p], sorted_[Origin(e)], sorted_[Destination(e)]) > 0;
+}
+
+bool DivideConquerDelaunay::RightOf(const std::uint32_t p, const std::size_t e) const noexcept
+{
+    return Orient2D(sorted_[p], sorted_[Destination(e)], sorted_[Origin(e)]) > 0;
+}
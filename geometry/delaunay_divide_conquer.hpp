@@ -0,0 +1,180 @@
+#pragma once
+
+#include "geometry/base.hpp"
+#include "geometry/triangle_mesh.hpp"
+#include "graph/base.hpp"
+#include "thread/thread_pool.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief quad-edge 上の分割統治 Delaunay 三角形分割 (Guibas-Stolfi, O(n log n))
+ * 点を (x, y) の辞書順に 1 度だけ並べ、左右半分の三角形分割を下から上へ併合する。
+ * スレッドプールを渡すと、大きい部分問題の左右半分を別のタスクで作る。
+ *
+ * 区間 [lo, hi) の部分問題は quad-edge の番号 [3 lo, 3 hi) だけを使う。
+ * k 点の平面グラフの辺は 3k 本未満なので足り、部分問題ごとの空き番号の連結リストで確保するので、
+ * 並列に動く部分問題どうしは配列の同じ場所に触らない。
+ *
+ * 有向辺 e は quad-edge q の 4q (向き) と 4q + 2 (逆向き)。4q + 1, 4q + 3 は双対の辺。
+ * 同じ座標の点は 2 つ目以降を使わない (辺を持たない)。
+ */
+class DivideConquerDelaunay
+{
+public:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::uint32_t>::max();
+    }
+
+    explicit DivideConquerDelaunay(const std::vector<Point2D>& position_list);
+    DivideConquerDelaunay(const std::vector<Point2D>& position_list, ThreadPool& pool);
+
+    // 点の数
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief quad-edge 番号の上限。使っていない番号も含むので IsAlive で確かめる
+     */
+    std::size_t EdgeCapacity() const noexcept
+    {
+        return origin_.size() / 2;
+    }
+
+    bool IsAlive(const std::size_t q) const noexcept
+    {
+        return origin_[2 * q] != None();
+    }
+
+    // 有向辺 e の始点 / 終点 (元の点の番号)
+    std::size_t Org(const std::size_t e) const noexcept
+    {
+        return index_[origin_[e / 2]];
+    }
+
+    std::size_t Dest(const std::size_t e) const noexcept
+    {
+        return index_[origin_[Sym(e) / 2]];
+    }
+
+    static std::size_t Sym(const std::size_t e) noexcept
+    {
+        return e ^ 2;
+    }
+
+    // 始点の周りを反時計回りに見た次の辺
+    std::size_t Onext(const std::size_t e) const noexcept
+    {
+        return next_[e];
+    }
+
+    // 左の面の周りを反時計回りに見た次の辺
+    std::size_t Lnext(const std::size_t e) const noexcept
+    {
+        return Rot(next_[InvRot(e)]);
+    }
+
+    /**
+     * @brief 凸包上の辺で、凸包の外側が右にあるもの (辺がなければ None())
+     */
+    std::size_t HullEdge() const noexcept
+    {
+        return hull_edge_;
+    }
+
+    /**
+     * @brief Delaunay 辺のグラフ (頂点の値は点の番号)
+     */
+    SparseGraph<int, int> GetGraph() const;
+
+    /**
+     * @brief 反時計回りの 3 辺で囲まれた面を三角形にした TriangleMesh
+     */
+    TriangleMesh GetTriangleMesh() const;
+
+private:
+    // 部分問題の空き quad-edge の連結リスト (next_[4q] で次を指す)
+    struct FreeList
+    {
+        std::uint32_t head = None();
+        std::uint32_t tail = None();
+    };
+
+    // 部分問題の結果。left は最左の点から出る凸包上の反時計回りの辺、right は最右の点から出る時計回りの辺
+    struct HullPair
+    {
+        std::uint32_t left;
+        std::uint32_t right;
+        FreeList free;
+    };
+
+    std::size_t size_ = 0;
+
+    // 並べた点の座標と元の番号 (重複を除く)
+    std::vector<Point2D> sorted_;
+    std::vector<std::size_t> index_;
+
+    // 有向辺 e (双対も含む) の Onext
+    std::vector<std::uint32_t> next_;
+
+    // 有向辺 e (主の辺のみ) の始点の sorted_ での番号は origin_[e / 2]。空きの quad-edge は origin_[2q] = None()
+    std::vector<std::uint32_t> origin_;
+
+    std::size_t hull_edge_ = None();
+
+    // 部分問題を新しいタスクにする最小の点数
+    std::size_t parallel_cutoff_ = 0;
+
+    static std::size_t Rot(const std::size_t e) noexcept
+    {
+        return (e & ~std::size_t(3)) | ((e + 1) & 3);
+    }
+
+    static std::size_t InvRot(const std::size_t e) noexcept
+    {
+        return (e & ~std::size_t(3)) | ((e + 3) & 3);
+    }
+
+    std::uint32_t Origin(const std::size_t e) const noexcept
+    {
+        return origin_[e / 2];
+    }
+
+    std::uint32_t Destination(const std::size_t e) const noexcept
+    {
+        return origin_[Sym(e) / 2];
+    }
+
+    std::size_t Oprev(const std::size_t e) const noexcept
+    {
+        return Rot(next_[Rot(e)]);
+    }
+
+    std::size_t Rprev(const std::size_t e) const noexcept
+    {
+        return next_[Sym(e)];
+    }
+
+    void Sort(const std::vector<Point2D>& position_list, ThreadPool* pool);
+
+    HullPair Build(std::uint32_t lo, std::uint32_t hi, ThreadPool* pool);
+    HullPair BuildLeaf(std::uint32_t lo, std::uint32_t hi);
+    HullPair Merge(HullPair left, HullPair right);
+
+    std::uint32_t Pop(FreeList& free);
+    std::uint32_t MakeEdge(std::uint32_t from, std::uint32_t to, FreeList& free);
+    void Splice(std::size_t a, std::size_t b);
+    std::uint32_t Connect(std::size_t a, std::size_t b, FreeList& free);
+    void DeleteEdge(std::size_t e, FreeList& free);
+
+    void Push(FreeList& free, std::uint32_t q);
+    FreeList Concat(FreeList a, FreeList b);
+
+    bool LeftOf(std::uint32_t p, std::size_t e) const noexcept;
+    bool RightOf(std::uint32_t p, std::size_t e) const noexcept;
+};
@@ -1,6 +1,27 @@
 #pragma once
 
 #include "geometry/base.hpp"
+#include "geometry/triangle_mesh.hpp"
 #include "graph/base.hpp"
+#include "thread/thread_pool.hpp"
 
-SparseGraph<int, int> GetDelaunayGraph(const std::vector<Point2D>& position_list);
\ No newline at end of file
+// Delaunay 三角形分割の作り方
+enum class DelaunayConstruction
+{
+    // BRIO 順に添加し、三角形の隣接配列上の walk で位置を探す (DelaunayTriangulation)
+    Walk,
+
+    // x 座標で並べて分割統治し、quad-edge 上で併合する (DivideConquerDelaunay)
+    DivideConquer,
+};
+
+SparseGraph<int, int> GetDelaunayGraph(const std::vector<Point2D>& position_list, const DelaunayConstruction construction = DelaunayConstruction::Walk);
+
+// 分割統治の左右半分を pool で並列に作る
+SparseGraph<int, int> GetDelaunayGraph(const std::vector<Point2D>& position_list, ThreadPool& pool);
+
+// 三角形と half-edge の配列で返す (DelaunayTriangulation を使う)。SparseGraph よりずっと小さい
+TriangleMesh GetDelaunayMesh(const std::vector<Point2D>& position_list);
+
+// 分割統治の左右半分を pool で並列に作り、三角形と half-edge の配列で返す
+TriangleMesh GetDelaunayMesh(const std::vector<Point2D>& position_list, ThreadPool& pool);
@@ -0,0 +1,740 @@
+#include "geometry/delaunay_triangulation.hpp"
+#include "geometry/predicates.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+static bool SamePosition(const Point2D& a, const Point2D& b) noexcept
+{
+    return a.x() == b.x() && a.y() == b.y();
+}
+
+// 2^16 x 2^16 の格子上の Hilbert 曲線の順番
+static std::uint64_t HilbertIndex(std::uint32_t x, std::uint32_t y) noexcept
+{
+    constexpr std::uint32_t n = 1u << 16;
+    std::uint64_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        const std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+        const std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+DelaunayTriangulation::DelaunayTriangulation(const std::vector<Point2D>& position_list)
+    : position_list_(position_list)
+    , removed_(position_list.size(), false)
+    , vertex_triangle_(position_list.size(), None())
+    , same_position_(position_list.size(), None())
+{
+    Build();
+}
+
+std::size_t DelaunayTriangulation::Insert(const Point2D& p, const std::size_t hint)
+{
+    const std::size_t index = size();
+    position_list_.push_back(p);
+    removed_.push_back(false);
+    vertex_triangle_.push_back(None());
+    same_position_.push_back(None());
+    link_.resize(size() + 1);
+
+    // 三角形がまだない (一直線上の点しかない) ときは作り直す
+    if (last_triangle_ == None())
+    {
+        Build();
+    }
+    else
+    {
+        if (hint < index && vertex_triangle_[hint] != None())
+        {
+            last_triangle_ = RealTriangle(vertex_triangle_[hint]);
+        }
+        AddVertex(index);
+    }
+    return index;
+}
+
+bool DelaunayTriangulation::Erase(const std::size_t index)
+{
+    if (removed_[index])
+    {
+        return false;
+    }
+    removed_[index] = true;
+    if (last_triangle_ == None())
+    {
+        Build();
+        return true;
+    }
+    if (vertex_triangle_[index] == None())
+    {
+        // 同じ座標の点があって添加しなかった点
+        return true;
+    }
+
+    // 同じ座標の点が残っていれば、頂点の番号を付け替えるだけで済む
+    std::size_t same = same_position_[index];
+    while (same != None() && removed_[same])
+    {
+        same = same_position_[same];
+    }
+    if (same != None())
+    {
+        const std::size_t start = vertex_triangle_[index];
+        std::size_t t = start;
+        do
+        {
+            std::size_t i = 0;
+            while (Vertex(t, i) != index)
+            {
+                i++;
+            }
+            vertices_[3 * t + i] = same;
+            t = Neighbor(t, (i + 1) % 3);
+        } while (t != start);
+        vertex_triangle_[same] = start;
+        vertex_triangle_[index] = None();
+        return true;
+    }
+
+    // index の周りの三角形を反時計回りに集める。穴の境界は反時計回りで、穴を左に見る
+    std::vector<std::size_t> hole;
+    boundary_.clear();
+    cavity_.clear();
+    std::size_t star_real = 0;
+    const std::size_t start = vertex_triangle_[index];
+    std::size_t t = start;
+    do
+    {
+        std::size_t i = 0;
+        while (Vertex(t, i) != index)
+        {
+            i++;
+        }
+        const std::size_t from = Vertex(t, (i + 1) % 3);
+        const std::size_t to = Vertex(t, (i + 2) % 3);
+        const std::size_t outside = Neighbor(t, i);
+        std::size_t j = 0;
+        while (Neighbor(outside, j) != t)
+        {
+            j++;
+        }
+        hole.push_back(from);
+        boundary_.push_back(BoundaryEdge { from, to, outside, j });
+        cavity_.push_back(t);
+        if (!IsGhost(t))
+        {
+            star_real++;
+        }
+        t = Neighbor(t, (i + 1) % 3);
+    } while (t != start);
+
+    // 残る点が全て穴の周りにあり一直線上に並ぶなら、三角形がなくなる
+    if (star_real == real_triangle_size_)
+    {
+        std::size_t first = None(), second = None();
+        bool collinear = true;
+        for (const auto v : hole)
+        {
+            if (v == Infinite())
+            {
+                continue;
+            }
+            if (first == None())
+            {
+                first = v;
+            }
+            else if (second == None())
+            {
+                second = v;
+            }
+            else if (Orient2D(Pos(first), Pos(second), Pos(v)) != 0)
+            {
+                collinear = false;
+                break;
+            }
+        }
+        if (collinear)
+        {
+            Build();
+            return true;
+        }
+    }
+
+    for (const auto c : cavity_)
+    {
+        DeleteTriangle(c);
+    }
+    vertex_triangle_[index] = None();
+
+    new_triangles_.clear();
+    FillHole(hole);
+    Stitch();
+    last_triangle_ = RealTriangle(new_triangles_.front());
+    return true;
+}
+
+/**
+ * @brief 消されていない点で三角形分割を作り直す
+ */
+void DelaunayTriangulation::Build()
+{
+    collinear_edges_.clear();
+    vertices_.clear();
+    neighbors_.clear();
+    free_triangles_.clear();
+    stamp_.clear();
+    in_cavity_.clear();
+    std::fill(vertex_triangle_.begin(), vertex_triangle_.end(), None());
+    std::fill(same_position_.begin(), same_position_.end(), None());
+    real_triangle_size_ = 0;
+    last_triangle_ = None();
+
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        if (!removed_[i])
+        {
+            indices.push_back(i);
+        }
+    }
+    const std::size_t n = indices.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    // BRIO: 各点を確率 1/2 で最後の段、1/4 でその前の段、... に振り、段の中は Hilbert 曲線順に並べる
+    Point2D mins = Pos(indices[0]);
+    Point2D maxs = Pos(indices[0]);
+    for (const auto i : indices)
+    {
+        mins = Point2D({ std::min(mins.x(), Pos(i).x()), std::min(mins.y(), Pos(i).y()) });
+        maxs = Point2D({ std::max(maxs.x(), Pos(i).x()), std::max(maxs.y(), Pos(i).y()) });
+    }
+    const double width = std::max(maxs.x() - mins.x(), maxs.y() - mins.y());
+    const double scale = width > 0 ? 65535.0 / width : 0.0;
+
+    std::vector<std::tuple<int, std::uint64_t, std::size_t>> keys(n);
+    for (std::size_t k = 0; k < n; k++)
+    {
+        const std::size_t i = indices[k];
+        int round = 0;
+        while (round < 32 && (NextRandom() & 1))
+        {
+            round++;
+        }
+        const auto x = static_cast<std::uint32_t>((Pos(i).x() - mins.x()) * scale);
+        const auto y = static_cast<std::uint32_t>((Pos(i).y() - mins.y()) * scale);
+        keys[k] = std::make_tuple(-round, HilbertIndex(x, y), i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::size_t> order(n);
+    for (std::size_t k = 0; k < n; k++)
+    {
+        order[k] = std::get<2>(keys[k]);
+    }
+
+    std::size_t first, second, third;
+    if (!Initialize(order, first, second, third))
+    {
+        BuildCollinear(order);
+        return;
+    }
+
+    link_.resize(size() + 1);
+    for (const auto index : order)
+    {
+        if (index != first && index != second && index != third)
+        {
+            AddVertex(index);
+        }
+    }
+}
+
+SparseGraph<int, int> DelaunayTriangulation::GetGraph() const
+{
+    SparseGraph<int, int> graph;
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        graph.push_node(i);
+    }
+    for (std::size_t t = 0; t < TriangleCapacity(); t++)
+    {
+        if (!IsAlive(t) || IsGhost(t))
+        {
+            continue;
+        }
+        // 凸包上の辺は片側の三角形にしか現れないので、向きによらず張る (既にある辺なら connect は重みを上書きするだけ)
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            graph.connect(Vertex(t, i), Vertex(t, (i + 1) % 3));
+        }
+    }
+    for (const auto& e : collinear_edges_)
+    {
+        graph.connect(e.first, e.second);
+    }
+    return graph;
+}
+
+TriangleMesh DelaunayTriangulation::GetTriangleMesh() const
+{
+    std::vector<std::uint32_t> id(TriangleCapacity(), TriangleMesh::None());
+    std::vector<std::uint32_t> triangles;
+    for (std::size_t t = 0; t < TriangleCapacity(); t++)
+    {
+        if (IsAlive(t) && !IsGhost(t))
+        {
+            id[t] = triangles.size() / 3;
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                triangles.push_back(Vertex(t, i));
+            }
+        }
+    }
+
+    // half-edge 3 id[t] + i (頂点 i -> i + 1) の向こうは、頂点 i + 2 の対辺の隣
+    std::vector<std::uint32_t> halfedges(triangles.size(), TriangleMesh::None());
+    for (std::size_t t = 0; t < TriangleCapacity(); t++)
+    {
+        if (id[t] == TriangleMesh::None())
+        {
+            continue;
+        }
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            const std::size_t u = Neighbor(t, (i + 2) % 3);
+            if (IsGhost(u))
+            {
+                continue;
+            }
+            const std::size_t to = Vertex(t, (i + 1) % 3);
+            for (std::size_t k = 0; k < 3; k++)
+            {
+                if (Vertex(u, k) == to)
+                {
+                    halfedges[3 * id[t] + i] = 3 * id[u] + k;
+                }
+            }
+        }
+    }
+    return TriangleMesh(size(), std::move(triangles), std::move(halfedges));
+}
+
+/**
+ * @brief 一直線上にない最初の 3 点で、三角形 1 つとそれを囲む ghost 三角形 3 つを作る
+ */
+bool DelaunayTriangulation::Initialize(const std::vector<std::size_t>& order, std::size_t& first, std::size_t& second, std::size_t& third)
+{
+    first = order[0];
+    second = None();
+    third = None();
+    for (const auto index : order)
+    {
+        if (second == None())
+        {
+            if (!SamePosition(Pos(first), Pos(index)))
+            {
+                second = index;
+            }
+        }
+        else if (Orient2D(Pos(first), Pos(second), Pos(index)) != 0)
+        {
+            third = index;
+            break;
+        }
+    }
+    if (third == None())
+    {
+        return false;
+    }
+
+    std::size_t a = first;
+    std::size_t b = second;
+    std::size_t c = third;
+    if (Orient2D(Pos(a), Pos(b), Pos(c)) < 0)
+    {
+        std::swap(b, c);
+    }
+
+    const std::size_t inf = Infinite();
+    const std::size_t t[4] = {
+        NewTriangle(a, b, c),
+        NewTriangle(b, a, inf),
+        NewTriangle(c, b, inf),
+        NewTriangle(a, c, inf),
+    };
+
+    // 逆向きの辺を共有する三角形同士をつなぐ
+    for (int x = 0; x < 4; x++)
+    {
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            const std::size_t from = Vertex(t[x], (i + 1) % 3);
+            const std::size_t to = Vertex(t[x], (i + 2) % 3);
+            for (int y = 0; y < 4; y++)
+            {
+                for (std::size_t j = 0; j < 3; j++)
+                {
+                    if (Vertex(t[y], (j + 1) % 3) == to && Vertex(t[y], (j + 2) % 3) == from)
+                    {
+                        neighbors_[3 * t[x] + i] = t[y];
+                    }
+                }
+            }
+        }
+    }
+    last_triangle_ = t[0];
+    return true;
+}
+
+// 全ての点が一直線上 (または 2 点以下) なら、並び順に隣り合う点を結ぶ
+void DelaunayTriangulation::BuildCollinear(const std::vector<std::size_t>& order)
+{
+    std::vector<std::size_t> sorted(order);
+    std::sort(sorted.begin(), sorted.end(), [&](const std::size_t i, const std::size_t j) {
+        return std::make_pair(Pos(i).x(), Pos(i).y()) < std::make_pair(Pos(j).x(), Pos(j).y());
+    });
+    for (std::size_t i = 1; i < sorted.size(); i++)
+    {
+        if (!SamePosition(Pos(sorted[i - 1]), Pos(sorted[i])))
+        {
+            collinear_edges_.emplace_back(sorted[i - 1], sorted[i]);
+        }
+    }
+}
+
+std::size_t DelaunayTriangulation::NewTriangle(const std::size_t a, const std::size_t b, const std::size_t c)
+{
+    std::size_t t;
+    if (free_triangles_.empty())
+    {
+        t = vertices_.size() / 3;
+        vertices_.resize(vertices_.size() + 3);
+        neighbors_.resize(neighbors_.size() + 3, None());
+        stamp_.push_back(0);
+        in_cavity_.push_back(false);
+    }
+    else
+    {
+        t = free_triangles_.back();
+        free_triangles_.pop_back();
+    }
+    vertices_[3 * t] = a;
+    vertices_[3 * t + 1] = b;
+    vertices_[3 * t + 2] = c;
+    for (const auto v : { a, b, c })
+    {
+        if (v != Infinite())
+        {
+            vertex_triangle_[v] = t;
+        }
+    }
+    if (!IsGhost(t))
+    {
+        real_triangle_size_++;
+    }
+    return t;
+}
+
+void DelaunayTriangulation::DeleteTriangle(const std::size_t t)
+{
+    if (!IsGhost(t))
+    {
+        real_triangle_size_--;
+    }
+    vertices_[3 * t] = None();
+    free_triangles_.push_back(t);
+}
+
+/**
+ * @brief p を含む三角形 (凸包の外なら ghost 三角形) を remembering stochastic walk で探す
+ * 辺を調べる順番を毎回ランダムにするので、一直線上の退化した配置でも同じ三角形を巡回しない。
+ */
+std::size_t DelaunayTriangulation::Locate(const Point2D& p)
+{
+    std::size_t t = last_triangle_;
+    std::size_t previous = None();
+    while (!IsGhost(t))
+    {
+        const std::size_t offset = NextRandom() % 3;
+        std::size_t next = None();
+        for (std::size_t k = 0; k < 3; k++)
+        {
+            const std::size_t i = (offset + k) % 3;
+            const std::size_t n = Neighbor(t, i);
+            if (n == previous)
+            {
+                continue;
+            }
+            if (Orient2D(Pos(Vertex(t, (i + 1) % 3)), Pos(Vertex(t, (i + 2) % 3)), p) < 0)
+            {
+                next = n;
+                break;
+            }
+        }
+        if (next == None())
+        {
+            return t;
+        }
+        previous = t;
+        t = next;
+    }
+    return t;
+}
+
+/**
+ * @brief 三角形 t の外接円の内側に p があるか
+ * ghost 三角形 (a, b, Infinite()) の外接円は、辺 a -> b の左側の開半平面と開線分 ab とみなす。
+ */
+bool DelaunayTriangulation::Conflict(const std::size_t t, const Point2D& p) const
+{
+    return Conflict(Vertex(t, 0), Vertex(t, 1), Vertex(t, 2), p);
+}
+
+// 頂点 (v0, v1, v2) の三角形の外接円の内側に p があるか
+bool DelaunayTriangulation::Conflict(const std::size_t v0, const std::size_t v1, const std::size_t v2, const Point2D& p) const
+{
+    if (v0 != Infinite() && v1 != Infinite() && v2 != Infinite())
+    {
+        return InCircle(Pos(v0), Pos(v1), Pos(v2), p) > 0;
+    }
+
+    std::size_t a, b;
+    if (v2 == Infinite())
+    {
+        a = v0;
+        b = v1;
+    }
+    else if (v0 == Infinite())
+    {
+        a = v1;
+        b = v2;
+    }
+    else
+    {
+        a = v2;
+        b = v0;
+    }
+    const double o = Orient2D(Pos(a), Pos(b), p);
+    if (o != 0)
+    {
+        return o > 0;
+    }
+    return dot(p - Pos(a), Pos(b) - Pos(a)) > 0 && dot(p - Pos(b), Pos(a) - Pos(b)) > 0;
+}
+
+/**
+ * @brief 点 index を添加する。既にある点と同じ座標なら何もせず false
+ */
+bool DelaunayTriangulation::AddVertex(const std::size_t index)
+{
+    const Point2D& p = Pos(index);
+    const std::size_t start = Locate(p);
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        const std::size_t v = Vertex(start, i);
+        if (v != Infinite() && SamePosition(Pos(v), p))
+        {
+            same_position_[index] = same_position_[v];
+            same_position_[v] = index;
+            return false;
+        }
+    }
+    if (!Conflict(start, p))
+    {
+        return false;
+    }
+
+    // 外接円に p を含む三角形を隣接を辿って集め、その境界を記録する
+    boundary_.clear();
+    cavity_.clear();
+    stack_.clear();
+
+    current_stamp_++;
+    stamp_[start] = current_stamp_;
+    in_cavity_[start] = true;
+    stack_.push_back(start);
+    while (!stack_.empty())
+    {
+        const std::size_t t = stack_.back();
+        stack_.pop_back();
+        cavity_.push_back(t);
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            const std::size_t n = Neighbor(t, i);
+            if (stamp_[n] != current_stamp_)
+            {
+                stamp_[n] = current_stamp_;
+                in_cavity_[n] = Conflict(n, p);
+                if (in_cavity_[n])
+                {
+                    stack_.push_back(n);
+                }
+            }
+            if (!in_cavity_[n])
+            {
+                std::size_t j = 0;
+                while (Neighbor(n, j) != t)
+                {
+                    j++;
+                }
+                boundary_.push_back(BoundaryEdge { Vertex(t, (i + 1) % 3), Vertex(t, (i + 2) % 3), n, j });
+            }
+        }
+    }
+
+    for (const auto t : cavity_)
+    {
+        DeleteTriangle(t);
+    }
+
+    // 境界の辺と p で三角形を張る
+    const std::size_t n = size();
+    const auto slot = [n](const std::size_t v) {
+        return v == Infinite() ? n : v;
+    };
+    new_triangles_.clear();
+    for (const auto& e : boundary_)
+    {
+        const std::size_t t = NewTriangle(e.from, e.to, index);
+        neighbors_[3 * t + 2] = e.outside;
+        neighbors_[3 * e.outside + e.outside_index] = t;
+        link_[slot(e.from)] = t;
+        new_triangles_.push_back(t);
+        if (e.from != Infinite() && e.to != Infinite())
+        {
+            last_triangle_ = t;
+        }
+    }
+    // (a, b, p) と (b, c, p) は辺 b - p を共有する
+    for (const auto t : new_triangles_)
+    {
+        const std::size_t next = link_[slot(Vertex(t, 1))];
+        neighbors_[3 * t] = next;
+        neighbors_[3 * next + 1] = t;
+    }
+    return true;
+}
+
+// ghost 三角形は常に正の向きとみなす
+bool DelaunayTriangulation::Positive(const std::size_t a, const std::size_t b, const std::size_t c) const
+{
+    if (a == Infinite() || b == Infinite() || c == Infinite())
+    {
+        return true;
+    }
+    return Orient2D(Pos(a), Pos(b), Pos(c)) > 0;
+}
+
+/**
+ * @brief 反時計回りの穴 hole を三角形で埋める
+ * 辺 hole[0] -> hole[1] の左にある頂点のうち、外接円に他の頂点を含まないものを選んで三角形を作り、残りの 2 つの穴を同じように埋める。
+ * 辺の左の頂点の外接円は入れ子になるので、候補は 1 回の走査で決まる。
+ */
+void DelaunayTriangulation::FillHole(const std::vector<std::size_t>& hole)
+{
+    std::vector<std::vector<std::size_t>> holes { hole };
+    while (!holes.empty())
+    {
+        const std::vector<std::size_t> h = std::move(holes.back());
+        holes.pop_back();
+        const std::size_t m = h.size();
+        if (m < 3)
+        {
+            continue;
+        }
+
+        std::size_t best = None();
+        for (std::size_t j = 2; j < m; j++)
+        {
+            if (!Positive(h[0], h[1], h[j]))
+            {
+                continue;
+            }
+            if (best == None() || (h[j] != Infinite() && Conflict(h[0], h[1], h[best], Pos(h[j]))))
+            {
+                best = j;
+            }
+        }
+        assert(best != None());
+        new_triangles_.push_back(NewTriangle(h[0], h[1], h[best]));
+
+        holes.emplace_back(h.begin() + 1, h.begin() + best + 1);
+        holes.emplace_back(h.begin() + best, h.end());
+        holes.back().push_back(h[0]);
+    }
+}
+
+/**
+ * @brief 穴を埋めた三角形同士と、穴の外側の三角形をつなぐ
+ */
+void DelaunayTriangulation::Stitch()
+{
+    for (const auto t : new_triangles_)
+    {
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            const std::size_t from = Vertex(t, (i + 1) % 3);
+            const std::size_t to = Vertex(t, (i + 2) % 3);
+            const auto it = std::find_if(boundary_.begin(), boundary_.end(), [&](const BoundaryEdge& e) {
+                return e.from == from && e.to == to;
+            });
+            if (it != boundary_.end())
+            {
+                neighbors_[3 * t + i] = it->outside;
+                neighbors_[3 * it->outside + it->outside_index] = t;
+                continue;
+            }
+            for (const auto u : new_triangles_)
+            {
+                for (std::size_t j = 0; j < 3; j++)
+                {
+                    if (Vertex(u, (j + 1) % 3) == to && Vertex(u, (j + 2) % 3) == from)
+                    {
+                        neighbors_[3 * t + i] = u;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Locate は ghost でない三角形から始める。ghost 三角形の凸包の辺の向こうは ghost でない
+std::size_t DelaunayTriangulation::RealTriangle(const std::size_t t) const
+{
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        if (Vertex(t, i) == Infinite())
+        {
+            return Neighbor(t, i);
+        }
+    }
+    return t;
+}
+
+// xorshift64
+std::uint64_t DelaunayTriangulation::NextRandom() noexcept
+{
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 7;
+    random_state_ ^= random_state_ << 17;
+    return random_state_;
+}
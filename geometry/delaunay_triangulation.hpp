@@ -0,0 +1,172 @@
+#pragma once
+
+#include "geometry/base.hpp"
+#include "geometry/triangle_mesh.hpp"
+#include "graph/base.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 三角形の隣接配列で持つ Delaunay 三角形分割 (逐次添加)
+ * 点は BRIO (ランダムな段に分け、段の中は Hilbert 曲線順) で添加し、直前に作った三角形から
+ * remembering stochastic walk で含む三角形を探して、外接円に点を含む三角形の集まり (cavity) を張り直す (Bowyer-Watson)。
+ * 凸包の外側は無限遠点 Infinite() を頂点に持つ ghost 三角形で覆うので、凸包の外への添加も同じ手順になる。
+ *
+ * 三角形 t の頂点は Vertex(t, 0..2) で反時計回り、Neighbor(t, i) は頂点 i の対辺 (Vertex(t, i + 1) -> Vertex(t, i + 2)) の向こうの三角形。
+ * 同じ座標の点は 2 つ目以降を添加しない (辺を持たない)。
+ *
+ * 構築後も Insert(p) / Erase(index) で点を増減でき、変わった部分だけを張り直す。
+ * Erase は点の周りの三角形を消し、できた穴を外接円が空の三角形で 1 つずつ埋める (凸包上の点も ghost 三角形ごと同じ手順)。
+ * 点の番号は消しても詰めない。同じ座標の点を消すと、添加しなかった点の 1 つが代わりに頂点になる。
+ */
+class DelaunayTriangulation
+{
+public:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    // ghost 三角形の無限遠の頂点
+    static constexpr std::size_t Infinite()
+    {
+        return std::numeric_limits<std::size_t>::max() - 1;
+    }
+
+    explicit DelaunayTriangulation(const std::vector<Point2D>& position_list);
+
+    // 点の数 (消した点も数える)
+    std::size_t size() const noexcept
+    {
+        return position_list_.size();
+    }
+
+    // 消されていない点か
+    bool Contains(const std::size_t index) const noexcept
+    {
+        return !removed_[index];
+    }
+
+    /**
+     * @brief 点 p を加え、その番号 (size() - 1) を返す
+     * @param hint p の近くにある点の番号。与えるとその点の周りから p を探す
+     */
+    std::size_t Insert(const Point2D& p, std::size_t hint = None());
+
+    /**
+     * @brief 点 index を消す。既に消してあれば false
+     */
+    bool Erase(std::size_t index);
+
+    const Point2D& Pos(const std::size_t index) const noexcept
+    {
+        return position_list_[index];
+    }
+
+    /**
+     * @brief 三角形番号の上限。削除済みの番号も含むので IsAlive で確かめる
+     */
+    std::size_t TriangleCapacity() const noexcept
+    {
+        return vertices_.size() / 3;
+    }
+
+    bool IsAlive(const std::size_t t) const noexcept
+    {
+        return vertices_[3 * t] != None();
+    }
+
+    bool IsGhost(const std::size_t t) const noexcept
+    {
+        return vertices_[3 * t] == Infinite() || vertices_[3 * t + 1] == Infinite() || vertices_[3 * t + 2] == Infinite();
+    }
+
+    std::size_t Vertex(const std::size_t t, const std::size_t i) const noexcept
+    {
+        return vertices_[3 * t + i];
+    }
+
+    std::size_t Neighbor(const std::size_t t, const std::size_t i) const noexcept
+    {
+        return neighbors_[3 * t + i];
+    }
+
+    /**
+     * @brief Delaunay 辺のグラフ (頂点の値は点の番号)
+     */
+    SparseGraph<int, int> GetGraph() const;
+
+    /**
+     * @brief ghost 以外の三角形を詰めた TriangleMesh
+     */
+    TriangleMesh GetTriangleMesh() const;
+
+private:
+    // cavity の境界の辺 (cavity 側の三角形での向き) と、その外側の三角形
+    struct BoundaryEdge
+    {
+        std::size_t from;
+        std::size_t to;
+        std::size_t outside;
+        std::size_t outside_index;
+    };
+
+    std::vector<Point2D> position_list_;
+    std::vector<bool> removed_;
+
+    // 点を頂点に持つ三角形の 1 つ (三角形分割に入っていなければ None())
+    std::vector<std::size_t> vertex_triangle_;
+
+    // 同じ座標のため添加しなかった次の点 (頂点から辿る。消した点も残る)
+    std::vector<std::size_t> same_position_;
+
+    // ghost でない三角形の数
+    std::size_t real_triangle_size_ = 0;
+
+    // 一直線上の点しかないときの辺
+    std::vector<std::pair<std::size_t, std::size_t>> collinear_edges_;
+
+    // 三角形 t の頂点 / 隣接三角形は [3t, 3t + 3)。削除済みの三角形は vertices_[3t] = None()
+    std::vector<std::size_t> vertices_;
+    std::vector<std::size_t> neighbors_;
+    std::vector<std::size_t> free_triangles_;
+
+    // 点の探索を始める三角形
+    std::size_t last_triangle_ = None();
+
+    // 添加の作業領域
+    std::vector<std::uint32_t> stamp_;
+    std::uint32_t current_stamp_ = 0;
+    std::vector<bool> in_cavity_;
+    std::vector<std::size_t> cavity_;
+    std::vector<std::size_t> stack_;
+    std::vector<BoundaryEdge> boundary_;
+    std::vector<std::size_t> new_triangles_;
+
+    // 新しい三角形で、その頂点から始まる境界辺を持つもの (番号 size() は Infinite() 用)
+    std::vector<std::size_t> link_;
+
+    std::uint64_t random_state_ = 88172645463325252ull;
+
+    void Build();
+    bool Initialize(const std::vector<std::size_t>& order, std::size_t& first, std::size_t& second, std::size_t& third);
+    void BuildCollinear(const std::vector<std::size_t>& order);
+
+    std::size_t NewTriangle(std::size_t a, std::size_t b, std::size_t c);
+    void DeleteTriangle(std::size_t t);
+
+    std::size_t Locate(const Point2D& p);
+    bool Conflict(std::size_t a, std::size_t b, std::size_t c, const Point2D& p) const;
+    bool Conflict(std::size_t t, const Point2D& p) const;
+    bool AddVertex(std::size_t index);
+
+    bool Positive(std::size_t a, std::size_t b, std::size_t c) const;
+    void FillHole(const std::vector<std::size_t>& hole);
+    void Stitch();
+    std::size_t RealTriangle(std::size_t t) const;
+
+    std::uint64_t NextRandom() noexcept;
+};
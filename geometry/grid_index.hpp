@@ -0,0 +1,426 @@
+#pragma once
+
+#include "geometry/base.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 外接箱を一辺 cell_size の格子に切り、升目ごとに点を並べた索引 (構築後に変更しない)
+ * 升目の点は counting sort で 1 本の配列に詰め、升目 c の点は [offsets_[c], offsets_[c + 1])。
+ * 一様に散らばった点なら、近傍探索は p の升目から近い升目の輪を広げるだけで終わる。
+ * 偏った点では k-d tree (KDTree) の方が速い。
+ *
+ * @tparam T 座標の型
+ * @tparam D 次元
+ */
+template <class T, std::size_t D>
+class GridIndex
+{
+public:
+    using PointType = Point<T, D>;
+    using CircleType = Circle<T, D>;
+
+    static constexpr std::size_t MaxCellsPerPoint = 4;
+
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    /**
+     * @param cell_size 升目の一辺。0 なら升目 1 つあたり 2 点ほどになるように決める。
+     * 升目の数が点数の MaxCellsPerPoint 倍を超えるなら、超えなくなるまで 2 倍ずつ大きくする
+     */
+    explicit GridIndex(const std::vector<PointType>& position_list, const double cell_size = 0)
+    {
+        const std::size_t n = position_list.size();
+        if (n == 0)
+        {
+            resolution_.fill(1);
+            offsets_.assign(2, 0);
+            return;
+        }
+        lower_ = ReduceMin(position_list);
+        const PointType upper = ReduceMax(position_list);
+
+        cell_size_ = cell_size;
+        if (!(cell_size_ > 0))
+        {
+            // 幅のある軸の体積を点数 / 2 等分する
+            double volume = 1;
+            std::size_t dimension = 0;
+            for (std::size_t a = 0; a < D; a++)
+            {
+                if (upper[a] > lower_[a])
+                {
+                    volume *= static_cast<double>(upper[a] - lower_[a]);
+                    dimension++;
+                }
+            }
+            cell_size_ = dimension == 0 ? 1.0 : std::pow(volume * 2 / n, 1.0 / dimension);
+            if (!(cell_size_ > 0))
+            {
+                cell_size_ = std::numeric_limits<double>::min();
+            }
+        }
+
+        // 升目が点数の MaxCellsPerPoint 倍を超えるほど細かい cell_size は 2 倍ずつ粗くする (ほぼ一直線上の点や小さすぎる指定)
+        const double max_cells = static_cast<double>(MaxCellsPerPoint * n);
+        while (true)
+        {
+            double cells = 1;
+            for (std::size_t a = 0; a < D; a++)
+            {
+                cells *= std::floor(static_cast<double>(upper[a] - lower_[a]) / cell_size_) + 1;
+            }
+            if (cells <= max_cells)
+            {
+                break;
+            }
+            cell_size_ *= 2;
+        }
+
+        std::size_t cell_count = 1;
+        for (std::size_t a = 0; a < D; a++)
+        {
+            resolution_[a] = static_cast<std::size_t>(static_cast<double>(upper[a] - lower_[a]) / cell_size_) + 1;
+            stride_[a] = cell_count;
+            cell_count *= resolution_[a];
+        }
+
+        std::vector<std::size_t> cells(n);
+        offsets_.assign(cell_count + 1, 0);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            cells[i] = CellOf(position_list[i]);
+            offsets_[cells[i] + 1]++;
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+        points_.resize(n);
+        indices_.resize(n);
+        std::vector<std::size_t> pos(offsets_.begin(), offsets_.end() - 1);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            points_[pos[cells[i]]] = position_list[i];
+            indices_[pos[cells[i]]++] = i;
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return points_.size();
+    }
+
+    double CellSize() const noexcept
+    {
+        return cell_size_;
+    }
+
+    /**
+     * @brief p に最も近い点の番号 (点がなければ None())
+     */
+    std::size_t Nearest(const PointType& p) const
+    {
+        std::size_t best = None();
+        T best_distance = 0;
+        SearchRings(
+            p,
+            [&](const std::size_t i) {
+                const T distance = (points_[i] - p).Norm2();
+                if (best == None() || distance < best_distance)
+                {
+                    best = i;
+                    best_distance = distance;
+                }
+            },
+            [&](const double reach2) {
+                return best != None() && reach2 >= static_cast<double>(best_distance);
+            });
+        return best == None() ? None() : indices_[best];
+    }
+
+    /**
+     * @brief p に近い順に min(k, size()) 点の番号
+     */
+    std::vector<std::size_t> KNearest(const PointType& p, const std::size_t k) const
+    {
+        // (距離の 2 乗, 位置) の最大ヒープ
+        std::vector<std::pair<T, std::size_t>> heap;
+        if (k > 0)
+        {
+            heap.reserve(k + 1);
+            SearchRings(
+                p,
+                [&](const std::size_t i) {
+                    const T distance = (points_[i] - p).Norm2();
+                    if (heap.size() < k)
+                    {
+                        heap.emplace_back(distance, i);
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                    else if (distance < heap.front().first)
+                    {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = std::make_pair(distance, i);
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                },
+                [&](const double reach2) {
+                    return heap.size() == k && reach2 >= static_cast<double>(heap.front().first);
+                });
+        }
+        std::sort_heap(heap.begin(), heap.end());
+
+        std::vector<std::size_t> ret;
+        ret.reserve(heap.size());
+        for (const auto& e : heap)
+        {
+            ret.push_back(indices_[e.second]);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief circle.Contain(p) な点の番号 (順不同)
+     */
+    std::vector<std::size_t> RadiusSearch(const CircleType& circle) const
+    {
+        std::vector<std::size_t> ret;
+        ForEachInBox(circle.Center() - circle.Radius(), circle.Center() + circle.Radius(), [&](const std::size_t i) {
+            if (circle.Contain(points_[i]))
+            {
+                ret.push_back(indices_[i]);
+            }
+        });
+        return ret;
+    }
+
+    /**
+     * @brief 各軸で box_min <= p <= box_max な点の番号 (順不同)
+     */
+    std::vector<std::size_t> BoxSearch(const PointType& box_min, const PointType& box_max) const
+    {
+        std::vector<std::size_t> ret;
+        ForEachInBox(box_min, box_max, [&](const std::size_t i) {
+            for (std::size_t a = 0; a < D; a++)
+            {
+                if (points_[i][a] < box_min[a] || box_max[a] < points_[i][a])
+                {
+                    return;
+                }
+            }
+            ret.push_back(indices_[i]);
+        });
+        return ret;
+    }
+
+private:
+    PointType lower_;
+    double cell_size_ = 1.0;
+    std::array<std::size_t, D> resolution_;
+    std::array<std::size_t, D> stride_;
+
+    std::vector<std::size_t> offsets_;
+    std::vector<PointType> points_;
+    std::vector<std::size_t> indices_;
+
+    // 軸 a の升目の番号 (格子の外は端の升目)
+    std::size_t AxisCell(const PointType& p, const std::size_t a) const noexcept
+    {
+        const double offset = static_cast<double>(p[a] - lower_[a]) / cell_size_;
+        if (!(offset > 0))
+        {
+            return 0;
+        }
+        if (offset >= static_cast<double>(resolution_[a] - 1))
+        {
+            return resolution_[a] - 1;
+        }
+        return static_cast<std::size_t>(offset);
+    }
+
+    std::size_t CellOf(const PointType& p) const noexcept
+    {
+        std::size_t c = 0;
+        for (std::size_t a = 0; a < D; a++)
+        {
+            c += AxisCell(p, a) * stride_[a];
+        }
+        return c;
+    }
+
+    // 升目の番号 [first, last] (各軸) の直方体を辞書順に回る
+    template <class Function>
+    void ForEachCell(const std::array<std::size_t, D>& first, const std::array<std::size_t, D>& last, Function func) const
+    {
+        std::array<std::size_t, D> cell = first;
+        while (true)
+        {
+            func(cell);
+            std::size_t a = 0;
+            while (a < D && cell[a] == last[a])
+            {
+                cell[a] = first[a];
+                a++;
+            }
+            if (a == D)
+            {
+                return;
+            }
+            cell[a]++;
+        }
+    }
+
+    /**
+     * @brief p の升目から Chebyshev 距離 r の升目の点を r = 0, 1, ... と visit に渡す
+     * 輪 r までを調べた後、残りの升目までの距離の 2 乗の下限で finished が true を返したら止める。
+     */
+    template <class Visit, class Finished>
+    void SearchRings(const PointType& p, Visit visit, Finished finished) const
+    {
+        if (size() == 0)
+        {
+            return;
+        }
+        std::array<std::size_t, D> center;
+        std::size_t max_radius = 0;
+        // 格子の外の p から格子の箱までの各軸の距離の 2 乗
+        std::array<double, D> outside;
+        for (std::size_t a = 0; a < D; a++)
+        {
+            center[a] = AxisCell(p, a);
+            max_radius = std::max({ max_radius, center[a], resolution_[a] - 1 - center[a] });
+            const double low = static_cast<double>(lower_[a]);
+            const double high = low + resolution_[a] * cell_size_;
+            const double gap = std::max({ low - static_cast<double>(p[a]), static_cast<double>(p[a]) - high, 0.0 });
+            outside[a] = gap * gap;
+        }
+
+        for (std::size_t r = 0; r <= max_radius; r++)
+        {
+            ForEachRing(center, r, [&](const std::size_t c) {
+                for (std::size_t i = offsets_[c]; i < offsets_[c + 1]; i++)
+                {
+                    visit(i);
+                }
+            });
+
+            // 残りの升目はどれかの軸 a で center から r + 1 以上離れる。その軸は次の升目の面まで、他の軸は格子の箱までの距離で抑える
+            bool rest = false;
+            double reach2 = std::numeric_limits<double>::infinity();
+            for (std::size_t a = 0; a < D; a++)
+            {
+                double others = 0;
+                for (std::size_t b = 0; b < D; b++)
+                {
+                    others += b == a ? 0.0 : outside[b];
+                }
+                const double low = static_cast<double>(lower_[a]);
+                const double x = static_cast<double>(p[a]);
+                if (center[a] > r)
+                {
+                    const double gap = std::max(x - (low + (center[a] - r) * cell_size_), 0.0);
+                    reach2 = std::min(reach2, others + gap * gap);
+                    rest = true;
+                }
+                if (center[a] + r + 1 < resolution_[a])
+                {
+                    const double gap = std::max(low + (center[a] + r + 1) * cell_size_ - x, 0.0);
+                    reach2 = std::min(reach2, others + gap * gap);
+                    rest = true;
+                }
+            }
+            if (!rest || finished(reach2))
+            {
+                return;
+            }
+        }
+    }
+
+    // center から Chebyshev 距離がちょうど r の升目。軸 a の面 (cell[a] = center[a] ± r) では、a より前の軸を内側に限って重複を避ける
+    template <class Function>
+    void ForEachRing(const std::array<std::size_t, D>& center, const std::size_t r, Function func) const
+    {
+        const auto visit = [&](const std::array<std::size_t, D>& cell) {
+            std::size_t c = 0;
+            for (std::size_t a = 0; a < D; a++)
+            {
+                c += cell[a] * stride_[a];
+            }
+            func(c);
+        };
+        if (r == 0)
+        {
+            visit(center);
+            return;
+        }
+
+        for (std::size_t a = 0; a < D; a++)
+        {
+            std::array<std::size_t, D> first, last;
+            bool empty = false;
+            for (std::size_t b = 0; b < D; b++)
+            {
+                const std::size_t width = b < a ? r - 1 : r;
+                first[b] = center[b] >= width ? center[b] - width : 0;
+                last[b] = std::min(center[b] + width, resolution_[b] - 1);
+                empty |= first[b] > last[b];
+            }
+            if (empty)
+            {
+                continue;
+            }
+            if (center[a] >= r)
+            {
+                first[a] = last[a] = center[a] - r;
+                ForEachCell(first, last, visit);
+            }
+            if (center[a] + r < resolution_[a])
+            {
+                first[a] = last[a] = center[a] + r;
+                ForEachCell(first, last, visit);
+            }
+        }
+    }
+
+    // 箱 [box_min, box_max] に掛かる升目の点の位置
+    template <class Function>
+    void ForEachInBox(const PointType& box_min, const PointType& box_max, Function func) const
+    {
+        if (size() == 0)
+        {
+            return;
+        }
+        std::array<std::size_t, D> first, last;
+        for (std::size_t a = 0; a < D; a++)
+        {
+            first[a] = AxisCell(box_min, a);
+            last[a] = AxisCell(box_max, a);
+            if (first[a] > last[a])
+            {
+                return;
+            }
+        }
+        ForEachCell(first, last, [&](const std::array<std::size_t, D>& cell) {
+            std::size_t c = 0;
+            for (std::size_t a = 0; a < D; a++)
+            {
+                c += cell[a] * stride_[a];
+            }
+            for (std::size_t i = offsets_[c]; i < offsets_[c + 1]; i++)
+            {
+                func(i);
+            }
+        });
+    }
+};
+
+using GridIndex2D = GridIndex<double, 2>;
+using GridIndex3D = GridIndex<double, 3>;
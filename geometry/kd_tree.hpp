@@ -0,0 +1,329 @@
+#pragma once
+
+#include "geometry/base.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 構築後に変更しない k-d tree (配列上の暗黙の木)
+ * 区間 [lo, hi) の節点は中央 mid = (lo + hi) / 2 の点で、左の子は [lo, mid)、右の子は [mid + 1, hi)。
+ * 分割軸は区間の外接箱の最も長い辺の軸で、左の子の点は軸の値が mid 以下、右の子は mid 以上。
+ * 点数が LeafSize 以下の区間は分割せずに全て調べる。子へのポインタを持たないので、点と元の番号の配列だけで済む。
+ *
+ * @tparam T 座標の型
+ * @tparam D 次元
+ */
+template <class T, std::size_t D>
+class KDTree
+{
+public:
+    using PointType = Point<T, D>;
+    using CircleType = Circle<T, D>;
+
+    static constexpr std::size_t LeafSize = 8;
+
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    explicit KDTree(const std::vector<PointType>& position_list)
+    {
+        const std::size_t n = position_list.size();
+        std::vector<std::pair<PointType, std::size_t>> entries;
+        entries.reserve(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            entries.emplace_back(position_list[i], i);
+        }
+        axis_.assign(n, 0);
+        if (n > 0)
+        {
+            Build(entries, 0, n, ReduceMin(position_list), ReduceMax(position_list));
+        }
+
+        points_.reserve(n);
+        indices_.reserve(n);
+        for (const auto& e : entries)
+        {
+            points_.push_back(e.first);
+            indices_.push_back(e.second);
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return points_.size();
+    }
+
+    /**
+     * @brief p に最も近い点の番号 (点がなければ None())
+     */
+    std::size_t Nearest(const PointType& p) const
+    {
+        if (size() == 0)
+        {
+            return None();
+        }
+        std::size_t best = 0;
+        T best_distance = (points_[0] - p).Norm2();
+        SearchNearest(0, size(), p, best, best_distance);
+        return indices_[best];
+    }
+
+    /**
+     * @brief p に近い順に min(k, size()) 点の番号
+     */
+    std::vector<std::size_t> KNearest(const PointType& p, const std::size_t k) const
+    {
+        // (距離の 2 乗, 位置) の最大ヒープ
+        std::vector<std::pair<T, std::size_t>> heap;
+        if (k > 0)
+        {
+            heap.reserve(k + 1);
+            SearchNearest(0, size(), p, k, heap);
+        }
+        std::sort_heap(heap.begin(), heap.end());
+
+        std::vector<std::size_t> ret;
+        ret.reserve(heap.size());
+        for (const auto& e : heap)
+        {
+            ret.push_back(indices_[e.second]);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief circle.Contain(p) な点の番号 (順不同)
+     */
+    std::vector<std::size_t> RadiusSearch(const CircleType& circle) const
+    {
+        std::vector<std::size_t> ret;
+        SearchCircle(0, size(), circle, ret);
+        return ret;
+    }
+
+    /**
+     * @brief 各軸で box_min <= p <= box_max な点の番号 (順不同)
+     */
+    std::vector<std::size_t> BoxSearch(const PointType& box_min, const PointType& box_max) const
+    {
+        std::vector<std::size_t> ret;
+        SearchBox(0, size(), box_min, box_max, ret);
+        return ret;
+    }
+
+private:
+    std::vector<PointType> points_;
+    std::vector<std::size_t> indices_;
+
+    // 区間の中央の点の分割軸
+    std::vector<std::uint8_t> axis_;
+
+    void Build(std::vector<std::pair<PointType, std::size_t>>& entries, const std::size_t lo, const std::size_t hi, PointType lower, PointType upper)
+    {
+        if (hi - lo <= LeafSize)
+        {
+            return;
+        }
+
+        std::size_t axis = 0;
+        for (std::size_t a = 1; a < D; a++)
+        {
+            if (upper[a] - lower[a] > upper[axis] - lower[axis])
+            {
+                axis = a;
+            }
+        }
+
+        const std::size_t mid = (lo + hi) / 2;
+        std::nth_element(entries.begin() + lo, entries.begin() + mid, entries.begin() + hi, [axis](const auto& e1, const auto& e2) {
+            return e1.first[axis] < e2.first[axis];
+        });
+        axis_[mid] = axis;
+
+        const T split = entries[mid].first[axis];
+        PointType left_upper = upper;
+        left_upper[axis] = split;
+        PointType right_lower = lower;
+        right_lower[axis] = split;
+        Build(entries, lo, mid, lower, left_upper);
+        Build(entries, mid + 1, hi, right_lower, upper);
+    }
+
+    void Visit(const std::size_t i, const PointType& p, const std::size_t k, std::vector<std::pair<T, std::size_t>>& heap) const
+    {
+        const T distance = (points_[i] - p).Norm2();
+        if (heap.size() < k)
+        {
+            heap.emplace_back(distance, i);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (distance < heap.front().first)
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = std::make_pair(distance, i);
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    void SearchNearest(const std::size_t lo, const std::size_t hi, const PointType& p, const std::size_t k, std::vector<std::pair<T, std::size_t>>& heap) const
+    {
+        if (hi - lo <= LeafSize)
+        {
+            for (std::size_t i = lo; i < hi; i++)
+            {
+                Visit(i, p, k, heap);
+            }
+            return;
+        }
+
+        // p のある側を先に調べ、分割面までの距離が今の k 番目より近いときだけ反対側も調べる
+        const std::size_t mid = (lo + hi) / 2;
+        const std::size_t axis = axis_[mid];
+        const T diff = p[axis] - points_[mid][axis];
+        Visit(mid, p, k, heap);
+        if (diff < 0)
+        {
+            SearchNearest(lo, mid, p, k, heap);
+            if (heap.size() < k || diff * diff < heap.front().first)
+            {
+                SearchNearest(mid + 1, hi, p, k, heap);
+            }
+        }
+        else
+        {
+            SearchNearest(mid + 1, hi, p, k, heap);
+            if (heap.size() < k || diff * diff < heap.front().first)
+            {
+                SearchNearest(lo, mid, p, k, heap);
+            }
+        }
+    }
+
+    // k = 1 のときはヒープを使わない
+    void SearchNearest(const std::size_t lo, const std::size_t hi, const PointType& p, std::size_t& best, T& best_distance) const
+    {
+        if (hi - lo <= LeafSize)
+        {
+            for (std::size_t i = lo; i < hi; i++)
+            {
+                const T distance = (points_[i] - p).Norm2();
+                if (distance < best_distance)
+                {
+                    best = i;
+                    best_distance = distance;
+                }
+            }
+            return;
+        }
+
+        const std::size_t mid = (lo + hi) / 2;
+        const std::size_t axis = axis_[mid];
+        const T diff = p[axis] - points_[mid][axis];
+        const T distance = (points_[mid] - p).Norm2();
+        if (distance < best_distance)
+        {
+            best = mid;
+            best_distance = distance;
+        }
+        if (diff < 0)
+        {
+            SearchNearest(lo, mid, p, best, best_distance);
+            if (diff * diff < best_distance)
+            {
+                SearchNearest(mid + 1, hi, p, best, best_distance);
+            }
+        }
+        else
+        {
+            SearchNearest(mid + 1, hi, p, best, best_distance);
+            if (diff * diff < best_distance)
+            {
+                SearchNearest(lo, mid, p, best, best_distance);
+            }
+        }
+    }
+
+    void SearchCircle(const std::size_t lo, const std::size_t hi, const CircleType& circle, std::vector<std::size_t>& ret) const
+    {
+        if (hi - lo <= LeafSize)
+        {
+            for (std::size_t i = lo; i < hi; i++)
+            {
+                if (circle.Contain(points_[i]))
+                {
+                    ret.push_back(indices_[i]);
+                }
+            }
+            return;
+        }
+
+        const std::size_t mid = (lo + hi) / 2;
+        const std::size_t axis = axis_[mid];
+        const T diff = circle.Center()[axis] - points_[mid][axis];
+        const T radius2 = circle.Radius() * circle.Radius();
+        if (circle.Contain(points_[mid]))
+        {
+            ret.push_back(indices_[mid]);
+        }
+        if (diff < 0 || diff * diff < radius2)
+        {
+            SearchCircle(lo, mid, circle, ret);
+        }
+        if (diff >= 0 || diff * diff < radius2)
+        {
+            SearchCircle(mid + 1, hi, circle, ret);
+        }
+    }
+
+    void SearchBox(const std::size_t lo, const std::size_t hi, const PointType& box_min, const PointType& box_max, std::vector<std::size_t>& ret) const
+    {
+        const auto inside = [&](const PointType& p) {
+            for (std::size_t a = 0; a < D; a++)
+            {
+                if (p[a] < box_min[a] || box_max[a] < p[a])
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        if (hi - lo <= LeafSize)
+        {
+            for (std::size_t i = lo; i < hi; i++)
+            {
+                if (inside(points_[i]))
+                {
+                    ret.push_back(indices_[i]);
+                }
+            }
+            return;
+        }
+
+        const std::size_t mid = (lo + hi) / 2;
+        const std::size_t axis = axis_[mid];
+        const T split = points_[mid][axis];
+        if (inside(points_[mid]))
+        {
+            ret.push_back(indices_[mid]);
+        }
+        if (box_min[axis] <= split)
+        {
+            SearchBox(lo, mid, box_min, box_max, ret);
+        }
+        if (split <= box_max[axis])
+        {
+            SearchBox(mid + 1, hi, box_min, box_max, ret);
+        }
+    }
+};
+
+using KDTree2D = KDTree<double, 2>;
+using KDTree3D = KDTree<double, 3>;
@@ -0,0 +1,289 @@
+#include "geometry/predicates.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// 2^-53 (1 回の丸めの相対誤差の上界)
+static constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;
+
+// 2^27 + 1。double を上下 26 bit ずつに分けるのに使う
+static constexpr double Splitter = 134217729.0;
+
+// 浮動小数点の計算結果の誤差の上界の係数 (Shewchuk の ccwerrboundA / iccerrboundA)
+static constexpr double OrientErrorBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+static constexpr double InCircleErrorBound = (10.0 + 96.0 * Epsilon) * Epsilon;
+
+// 絶対値の小さい順に並んだ、互いに重ならない double の和。0 の成分は持たない (空なら 0)
+using Expansion = std::vector<double>;
+
+// a + b = x + y (x は丸めた和、y は誤差)
+static void TwoSum(const double a, const double b, double& x, double& y) noexcept
+{
+    x = a + b;
+    const double b_virtual = x - a;
+    const double a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// |a| >= |b| のときの TwoSum
+static void FastTwoSum(const double a, const double b, double& x, double& y) noexcept
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// a - b = x + y
+static void TwoDiff(const double a, const double b, double& x, double& y) noexcept
+{
+    x = a - b;
+    const double b_virtual = a - x;
+    const double a_virtual = x + b_virtual;
+    y = (a - a_virtual) + (b_virtual - b);
+}
+
+// a = high + low (それぞれ 26 bit 以下の仮数)
+static void Split(const double a, double& high, double& low) noexcept
+{
+    const double c = Splitter * a;
+    const double a_big = c - a;
+    high = c - a_big;
+    low = a - high;
+}
+
+// a * b = x + y
+static void TwoProduct(const double a, const double b, double& x, double& y) noexcept
+{
+    x = a * b;
+    double a_high, a_low, b_high, b_low;
+    Split(a, a_high, a_low);
+    Split(b, b_high, b_low);
+    const double error1 = x - a_high * b_high;
+    const double error2 = error1 - a_low * b_high;
+    const double error3 = error2 - a_high * b_low;
+    y = a_low * b_low - error3;
+}
+
+static Expansion Difference(const double a, const double b)
+{
+    double x, y;
+    TwoDiff(a, b, x, y);
+    Expansion ret;
+    if (y != 0.0)
+    {
+        ret.push_back(y);
+    }
+    if (x != 0.0)
+    {
+        ret.push_back(x);
+    }
+    return ret;
+}
+
+// e + b
+static Expansion Grow(const Expansion& e, const double b)
+{
+    Expansion ret;
+    ret.reserve(e.size() + 1);
+    double q = b;
+    for (const double component : e)
+    {
+        double sum, error;
+        TwoSum(q, component, sum, error);
+        q = sum;
+        if (error != 0.0)
+        {
+            ret.push_back(error);
+        }
+    }
+    if (q != 0.0)
+    {
+        ret.push_back(q);
+    }
+    return ret;
+}
+
+// e + f
+static Expansion Sum(const Expansion& e, const Expansion& f)
+{
+    Expansion ret = e;
+    for (const double component : f)
+    {
+        ret = Grow(ret, component);
+    }
+    return ret;
+}
+
+// e * b
+static Expansion Scale(const Expansion& e, const double b)
+{
+    Expansion ret;
+    if (e.empty() || b == 0.0)
+    {
+        return ret;
+    }
+    ret.reserve(2 * e.size());
+
+    double q, error;
+    TwoProduct(e[0], b, q, error);
+    if (error != 0.0)
+    {
+        ret.push_back(error);
+    }
+    for (std::size_t i = 1; i < e.size(); i++)
+    {
+        double product_high, product_low, sum;
+        TwoProduct(e[i], b, product_high, product_low);
+        TwoSum(q, product_low, sum, error);
+        if (error != 0.0)
+        {
+            ret.push_back(error);
+        }
+        FastTwoSum(product_high, sum, q, error);
+        if (error != 0.0)
+        {
+            ret.push_back(error);
+        }
+    }
+    if (q != 0.0)
+    {
+        ret.push_back(q);
+    }
+    return ret;
+}
+
+// e * f
+static Expansion Product(const Expansion& e, const Expansion& f)
+{
+    Expansion ret;
+    for (const double component : f)
+    {
+        ret = Sum(ret, Scale(e, component));
+    }
+    return ret;
+}
+
+static Expansion Negate(Expansion e)
+{
+    for (auto& component : e)
+    {
+        component = -component;
+    }
+    return e;
+}
+
+// 小さい成分から足すので、符号は最大の成分と一致する
+static double Estimate(const Expansion& e) noexcept
+{
+    double ret = 0.0;
+    for (const double component : e)
+    {
+        ret += component;
+    }
+    return ret;
+}
+
+static double Orient2DExact(const Point2D& a, const Point2D& b, const Point2D& c)
+{
+    const Expansion acx = Difference(a.x(), c.x());
+    const Expansion acy = Difference(a.y(), c.y());
+    const Expansion bcx = Difference(b.x(), c.x());
+    const Expansion bcy = Difference(b.y(), c.y());
+    return Estimate(Sum(Product(acx, bcy), Negate(Product(acy, bcx))));
+}
+
+static double InCircleExact(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d)
+{
+    const Expansion adx = Difference(a.x(), d.x());
+    const Expansion ady = Difference(a.y(), d.y());
+    const Expansion bdx = Difference(b.x(), d.x());
+    const Expansion bdy = Difference(b.y(), d.y());
+    const Expansion cdx = Difference(c.x(), d.x());
+    const Expansion cdy = Difference(c.y(), d.y());
+
+    const Expansion a_lift = Sum(Product(adx, adx), Product(ady, ady));
+    const Expansion b_lift = Sum(Product(bdx, bdx), Product(bdy, bdy));
+    const Expansion c_lift = Sum(Product(cdx, cdx), Product(cdy, cdy));
+
+    const Expansion bc = Sum(Product(bdx, cdy), Negate(Product(cdx, bdy)));
+    const Expansion ca = Sum(Product(cdx, ady), Negate(Product(adx, cdy)));
+    const Expansion ab = Sum(Product(adx, bdy), Negate(Product(bdx, ady)));
+
+    return Estimate(Sum(Sum(Product(a_lift, bc), Product(b_lift, ca)), Product(c_lift, ab)));
+}
+
+double Orient2D(const Point2D& a, const Point2D& b, const Point2D& c) noexcept
+{
+    const double left = (a.x() - c.x()) * (b.y() - c.y());
+    const double right = (a.y() - c.y()) * (b.x() - c.x());
+    const double det = left - right;
+
+    // 2 項の符号が違えば打ち消しが起きないので、丸めても符号は正しい
+    double det_sum;
+    if (left > 0.0)
+    {
+        if (right <= 0.0)
+        {
+            return det;
+        }
+        det_sum = left + right;
+    }
+    else if (left < 0.0)
+    {
+        if (right >= 0.0)
+        {
+            return det;
+        }
+        det_sum = -left - right;
+    }
+    else
+    {
+        return det;
+    }
+
+    const double error_bound = OrientErrorBound * det_sum;
+    if (det >= error_bound || -det >= error_bound)
+    {
+        return det;
+    }
+    return Orient2DExact(a, b, c);
+}
+
+double InCircle(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) noexcept
+{
+    const double adx = a.x() - d.x();
+    const double ady = a.y() - d.y();
+    const double bdx = b.x() - d.x();
+    const double bdy = b.y() - d.y();
+    const double cdx = c.x() - d.x();
+    const double cdy = c.y() - d.y();
+
+    const double bdx_cdy = bdx * cdy;
+    const double cdx_bdy = cdx * bdy;
+    const double a_lift = adx * adx + ady * ady;
+
+    const double cdx_ady = cdx * ady;
+    const double adx_cdy = adx * cdy;
+    const double b_lift = bdx * bdx + bdy * bdy;
+
+    const double adx_bdy = adx * bdy;
+    const double bdx_ady = bdx * ady;
+    const double c_lift = cdx * cdx + cdy * cdy;
+
+    const double det = a_lift * (bdx_cdy - cdx_bdy) + b_lift * (cdx_ady - adx_cdy) + c_lift * (adx_bdy - bdx_ady);
+
+    const double permanent = (std::abs(bdx_cdy) + std::abs(cdx_bdy)) * a_lift
+        + (std::abs(cdx_ady) + std::abs(adx_cdy)) * b_lift
+        + (std::abs(adx_bdy) + std::abs(bdx_ady)) * c_lift;
+    const double error_bound = InCircleErrorBound * permanent;
+    if (det > error_bound || -det > error_bound)
+    {
+        return det;
+    }
+    // 全ての項が 0 (d が a, b, c のどれかと同じ点のときなど)
+    if (permanent == 0.0)
+    {
+        return 0.0;
+    }
+    return InCircleExact(a, b, c, d);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "geometry/base.hpp"
+
+// Shewchuk の適応精度の述語 (Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates)
+// まず浮動小数点で計算し、誤差の上界より値が大きければそのまま返す。
+// 足りなければ expansion (重ならない double の和) で厳密に計算し直すので、符号は常に正しい。
+// 絶対値は近似値なので、符号だけを使うこと。
+
+// a, b, c が反時計回りなら正、時計回りなら負、一直線上なら 0
+double Orient2D(const Point2D& a, const Point2D& b, const Point2D& c) noexcept;
+
+// 反時計回りの a, b, c の外接円の内側に d があれば正、外側なら負、円周上なら 0
+// (a, b, c が時計回りなら符号が逆になる)
+double InCircle(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) noexcept;
@@ -0,0 +1,259 @@
+#include "geometry/proximity_graph.hpp"
+#include "geometry/delaunay_graph.hpp"
+#include "geometry/predicates.hpp"
+#include "graph/minimum_spanning_tree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+static SparseGraph<int, double> MakeEmptyGraph(const std::size_t size, const bool undirected)
+{
+    SparseGraph<int, double> graph(undirected);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        graph.push_node(i);
+    }
+    return graph;
+}
+
+static double Distance(const Point2D& p1, const Point2D& p2) noexcept
+{
+    return std::sqrt((p1 - p2).Norm2());
+}
+
+// GetDelaunayGraph は 2 点以上を前提にしているので、それ未満なら辺のないグラフを返す
+static SparseGraph<int, int> GetDelaunayGraphOrEmpty(const std::vector<Point2D>& position_list)
+{
+    if (position_list.size() < 2)
+    {
+        SparseGraph<int, int> graph;
+        for (std::size_t i = 0; i < position_list.size(); i++)
+        {
+            graph.push_node(i);
+        }
+        return graph;
+    }
+    return GetDelaunayGraph(position_list);
+}
+
+// Delaunay グラフを中心 p からの距離の小さい順に辿る (best-first 探索)。
+// p の i 番目に近い点は、p かそれより近い点のどれかと Delaunay 辺で結ばれているので、取り出した順が近い順になる。
+class NearestWalker
+{
+public:
+    NearestWalker(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay)
+        : position_list_(position_list)
+        , delaunay_(delaunay)
+        , visited_(position_list.size(), false)
+    {
+    }
+
+    void Reset(const std::size_t center)
+    {
+        for (auto v : touched_)
+        {
+            visited_[v] = false;
+        }
+        touched_.clear();
+        heap_.clear();
+
+        center_ = center;
+        visited_[center] = true;
+        touched_.push_back(center);
+        Expand(center);
+    }
+
+    /**
+     * @brief 次に近い点と距離の 2 乗を返す。残っていなければ false
+     */
+    bool Next(std::size_t& v, double& distance2)
+    {
+        if (heap_.empty())
+        {
+            return false;
+        }
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+        distance2 = heap_.back().first;
+        v = heap_.back().second;
+        heap_.pop_back();
+        Expand(v);
+        return true;
+    }
+
+private:
+    using Element = std::pair<double, std::size_t>;
+
+    const std::vector<Point2D>& position_list_;
+    const SparseGraph<int, int>& delaunay_;
+
+    std::size_t center_ = 0;
+    std::vector<Element> heap_;
+    std::vector<bool> visited_;
+    std::vector<std::size_t> touched_;
+
+    void Expand(const std::size_t v)
+    {
+        for (const std::size_t nv : delaunay_.neighbor(v))
+        {
+            if (!visited_[nv])
+            {
+                visited_[nv] = true;
+                touched_.push_back(nv);
+                heap_.emplace_back((position_list_[nv] - position_list_[center_]).Norm2(), nv);
+                std::push_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+            }
+        }
+    }
+};
+
+SparseGraph<int, double> GetEuclideanMST(const std::vector<Point2D>& position_list)
+{
+    return GetEuclideanMST(position_list, GetDelaunayGraphOrEmpty(position_list));
+}
+
+SparseGraph<int, double> GetEuclideanMST(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay)
+{
+    // Euclid 最小全域木は Delaunay グラフに含まれる
+    auto weighted = MakeEmptyGraph(position_list.size(), true);
+    for (std::size_t p = 0; p < delaunay.size(); p++)
+    {
+        for (const std::size_t q : delaunay.neighbor(p))
+        {
+            if (p < q)
+            {
+                weighted.connect(p, q, Distance(position_list[p], position_list[q]));
+            }
+        }
+    }
+
+    auto tree = MakeEmptyGraph(position_list.size(), true);
+    for (const auto& e : kruskal(weighted).edges)
+    {
+        tree.connect(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+    }
+    return tree;
+}
+
+SparseGraph<int, double> GetGabrielGraph(const std::vector<Point2D>& position_list)
+{
+    return GetGabrielGraph(position_list, GetDelaunayGraphOrEmpty(position_list));
+}
+
+SparseGraph<int, double> GetGabrielGraph(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay)
+{
+    auto graph = MakeEmptyGraph(position_list.size(), true);
+    std::vector<std::size_t> around;
+    for (std::size_t p = 0; p < delaunay.size(); p++)
+    {
+        // p の隣接点を p の周りの偏角順に並べる。全体で O(n log n)
+        const Point2D& center = position_list[p];
+        const auto neighbors = delaunay.neighbor(p);
+        around.assign(neighbors.begin(), neighbors.end());
+        const auto upper = [&](const std::size_t v) {
+            const Point2D d = position_list[v] - center;
+            return d.y() > 0 || (d.y() == 0 && d.x() > 0);
+        };
+        std::sort(around.begin(), around.end(), [&](const std::size_t a, const std::size_t b) {
+            const bool ua = upper(a);
+            const bool ub = upper(b);
+            if (ua != ub)
+            {
+                return ua;
+            }
+            return Orient2D(center, position_list[a], position_list[b]) > 0;
+        });
+
+        // 円に点が入るなら pq を辺に持つ三角形の頂点が入り、それは偏角順で q の前後の点。
+        // 三角形の頂点でない点を調べても、円の内部にあれば pq は Gabriel 辺ではないので誤らない。
+        // r が円の内部 <=> 角 prq が鈍角
+        const std::size_t m = around.size();
+        for (std::size_t j = 0; j < m; j++)
+        {
+            const std::size_t q = around[j];
+            if (q <= p)
+            {
+                continue;
+            }
+            bool empty = true;
+            for (const std::size_t r : { around[(j + m - 1) % m], around[(j + 1) % m] })
+            {
+                if (r != q && dot(position_list[p] - position_list[r], position_list[q] - position_list[r]) < 0)
+                {
+                    empty = false;
+                }
+            }
+            if (empty)
+            {
+                graph.connect(p, q, Distance(position_list[p], position_list[q]));
+            }
+        }
+    }
+    return graph;
+}
+
+SparseGraph<int, double> GetRelativeNeighborhoodGraph(const std::vector<Point2D>& position_list)
+{
+    return GetRelativeNeighborhoodGraph(position_list, GetDelaunayGraphOrEmpty(position_list));
+}
+
+SparseGraph<int, double> GetRelativeNeighborhoodGraph(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay)
+{
+    // 相対近傍グラフは Gabriel グラフの部分グラフなので、Gabriel 辺 pq についてだけ、
+    // p から |pq| 未満の点を近い順に列挙して lune (q からも |pq| 未満) に入るものを探す
+    const auto gabriel = GetGabrielGraph(position_list, delaunay);
+    auto graph = MakeEmptyGraph(position_list.size(), true);
+    NearestWalker walker(position_list, delaunay);
+    for (std::size_t p = 0; p < gabriel.size(); p++)
+    {
+        for (const auto& adj : gabriel.adjacent(p))
+        {
+            const std::size_t q = adj.first;
+            if (q <= p)
+            {
+                continue;
+            }
+
+            const double pq = (position_list[p] - position_list[q]).Norm2();
+            bool empty = true;
+            walker.Reset(p);
+            std::size_t r;
+            double pr;
+            while (empty && walker.Next(r, pr) && pr < pq)
+            {
+                empty = r == q || (position_list[q] - position_list[r]).Norm2() >= pq;
+            }
+            if (empty)
+            {
+                graph.connect(p, q, gabriel.edge_at(adj.second));
+            }
+        }
+    }
+    return graph;
+}
+
+SparseGraph<int, double> GetKNearestNeighborGraph(const std::vector<Point2D>& position_list, const std::size_t k)
+{
+    return GetKNearestNeighborGraph(position_list, k, GetDelaunayGraphOrEmpty(position_list));
+}
+
+SparseGraph<int, double> GetKNearestNeighborGraph(const std::vector<Point2D>& position_list, const std::size_t k, const SparseGraph<int, int>& delaunay)
+{
+    const std::size_t n = position_list.size();
+    auto graph = MakeEmptyGraph(n, false);
+    NearestWalker walker(position_list, delaunay);
+    for (std::size_t p = 0; p < n; p++)
+    {
+        walker.Reset(p);
+        std::size_t v;
+        double distance2;
+        for (std::size_t i = 0; i < k && walker.Next(v, distance2); i++)
+        {
+            graph.connect(p, v, std::sqrt(distance2));
+        }
+    }
+    return graph;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "geometry/base.hpp"
+#include "graph/base.hpp"
+
+#include <vector>
+
+// Delaunay グラフの部分グラフ / Delaunay グラフから求まる近接グラフ
+// いずれも頂点の値は点の番号、辺の重みは Euclid 距離。
+// delaunay を受け取る版は GetDelaunayGraph(position_list) の結果を使い回す。
+
+// Euclid 最小全域木 (点が 1 つ以下なら辺なし)
+SparseGraph<int, double> GetEuclideanMST(const std::vector<Point2D>& position_list);
+SparseGraph<int, double> GetEuclideanMST(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay);
+
+// Gabriel グラフ: 辺 pq を直径とする円の内部に他の点がない
+// Delaunay 辺ごとに両側の三角形の頂点だけを調べる。隣接点を偏角順に並べるので O(n log n)
+SparseGraph<int, double> GetGabrielGraph(const std::vector<Point2D>& position_list);
+SparseGraph<int, double> GetGabrielGraph(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay);
+
+// 相対近傍グラフ: max(|pr|, |qr|) < |pq| となる点 r がない
+// Gabriel 辺 pq ごとに p から |pq| 未満の点を近い順に列挙するので、O(n log n + Σ k_pq log k_pq) (k_pq は p から |pq| 未満の点の数)。
+// k_pq は点の散らばり方で決まり n には依らないが、遠い点との Gabriel 辺の周りに点が密集すると最悪 O(n^2 log n)
+SparseGraph<int, double> GetRelativeNeighborhoodGraph(const std::vector<Point2D>& position_list);
+SparseGraph<int, double> GetRelativeNeighborhoodGraph(const std::vector<Point2D>& position_list, const SparseGraph<int, int>& delaunay);
+
+// 各点から近い順に k 点への有向辺を張ったグラフ
+SparseGraph<int, double> GetKNearestNeighborGraph(const std::vector<Point2D>& position_list, const std::size_t k);
+SparseGraph<int, double> GetKNearestNeighborGraph(const std::vector<Point2D>& position_list, const std::size_t k, const SparseGraph<int, int>& delaunay);
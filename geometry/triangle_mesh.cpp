@@ -0,0 +1,68 @@
+#include "geometry/triangle_mesh.hpp"
+
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+TriangleMesh::TriangleMesh(const std::size_t point_size, std::vector<std::uint32_t> triangles, std::vector<std::uint32_t> halfedges)
+    : point_size_(point_size)
+    , triangles_(std::move(triangles))
+    , halfedges_(std::move(halfedges))
+{
+    assert(triangles_.size() % 3 == 0 && triangles_.size() == halfedges_.size());
+
+    // 凸包上の half-edge は内側を左に見て反時計回りに繋がる
+    std::vector<std::uint32_t> hull_next(point_size_, None());
+    std::size_t start = None();
+    for (std::size_t e = 0; e < halfedges_.size(); e++)
+    {
+        if (halfedges_[e] == None())
+        {
+            hull_next[Origin(e)] = Target(e);
+            start = Origin(e);
+        }
+    }
+    if (start == None())
+    {
+        return;
+    }
+
+    std::size_t v = start;
+    do
+    {
+        hull_.push_back(v);
+        v = hull_next[v];
+    } while (v != start);
+}
+
+CSRGraph<std::size_t, std::size_t> TriangleMesh::GetCSRGraph() const
+{
+    // 内部の辺は両向きの half-edge が 1 本ずつあり、凸包上の辺は逆向きを補う
+    std::vector<std::size_t> offsets(point_size_ + 1, 0);
+    for (std::size_t e = 0; e < triangles_.size(); e++)
+    {
+        offsets[Origin(e) + 1]++;
+        if (halfedges_[e] == None())
+        {
+            offsets[Target(e) + 1]++;
+        }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::size_t> targets(offsets.back());
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    for (std::size_t e = 0; e < triangles_.size(); e++)
+    {
+        targets[pos[Origin(e)]++] = Target(e);
+        if (halfedges_[e] == None())
+        {
+            targets[pos[Target(e)]++] = Origin(e);
+        }
+    }
+
+    std::vector<std::size_t> nodes(point_size_);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::vector<std::size_t> weights(targets.size(), 0);
+    return CSRGraph<std::size_t, std::size_t>(std::move(nodes), std::move(offsets), std::move(targets), std::move(weights), true);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "graph/csr_graph.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief 平らな配列で持つ三角形分割 (half-edge 付き)
+ * 三角形 t の頂点 (点の番号) は triangles[3t, 3t + 3) に反時計回りに並ぶ。
+ * half-edge e = 3t + i は頂点 i から頂点 i + 1 へ向かい、HalfEdges()[e] はその逆向きの half-edge (凸包上なら None())。
+ * 点 1 つあたり 4 byte の配列 12 本分ほどで済み、SparseGraph のように辺ごとのハッシュを持たない。
+ *
+ * 一直線上の点しかないときは三角形がない。
+ */
+class TriangleMesh
+{
+public:
+    static constexpr std::uint32_t None()
+    {
+        return std::numeric_limits<std::uint32_t>::max();
+    }
+
+    TriangleMesh() = default;
+
+    /**
+     * @param point_size 点の数 (三角形に使われない点も数える)
+     * @param triangles 反時計回りの三角形の頂点の列
+     * @param halfedges 逆向きの half-edge の列
+     */
+    TriangleMesh(std::size_t point_size, std::vector<std::uint32_t> triangles, std::vector<std::uint32_t> halfedges);
+
+    // 点の数
+    std::size_t size() const noexcept
+    {
+        return point_size_;
+    }
+
+    std::size_t TriangleSize() const noexcept
+    {
+        return triangles_.size() / 3;
+    }
+
+    std::size_t Vertex(const std::size_t t, const std::size_t i) const noexcept
+    {
+        return triangles_[3 * t + i];
+    }
+
+    const std::vector<std::uint32_t>& Triangles() const noexcept
+    {
+        return triangles_;
+    }
+
+    const std::vector<std::uint32_t>& HalfEdges() const noexcept
+    {
+        return halfedges_;
+    }
+
+    /**
+     * @brief 凸包上の点を反時計回りに並べたもの
+     */
+    const std::vector<std::uint32_t>& Hull() const noexcept
+    {
+        return hull_;
+    }
+
+    // 同じ三角形の次 / 前の half-edge
+    static std::size_t Next(const std::size_t e) noexcept
+    {
+        return e % 3 == 2 ? e - 2 : e + 1;
+    }
+
+    static std::size_t Prev(const std::size_t e) noexcept
+    {
+        return e % 3 == 0 ? e + 2 : e - 1;
+    }
+
+    std::size_t Twin(const std::size_t e) const noexcept
+    {
+        return halfedges_[e];
+    }
+
+    // half-edge e の始点 / 終点
+    std::size_t Origin(const std::size_t e) const noexcept
+    {
+        return triangles_[e];
+    }
+
+    std::size_t Target(const std::size_t e) const noexcept
+    {
+        return triangles_[Next(e)];
+    }
+
+    /**
+     * @brief 三角形 t の辺 (Vertex(t, i), Vertex(t, i + 1)) の向こうの三角形 (凸包上なら None())
+     */
+    std::size_t NeighborTriangle(const std::size_t t, const std::size_t i) const noexcept
+    {
+        const std::size_t twin = halfedges_[3 * t + i];
+        return twin == None() ? None() : twin / 3;
+    }
+
+    /**
+     * @brief 辺の隣接を CSR にしたもの (頂点の値は点の番号、辺の重みは 0)
+     */
+    CSRGraph<std::size_t, std::size_t> GetCSRGraph() const;
+
+private:
+    std::size_t point_size_ = 0;
+
+    std::vector<std::uint32_t> triangles_;
+    std::vector<std::uint32_t> halfedges_;
+    std::vector<std::uint32_t> hull_;
+};
@@ -0,0 +1,272 @@
+#include "geometry/voronoi_diagram.hpp"
+#include "geometry/delaunay_graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 凸多角形 points を半平面 dot(normal, x) <= offset で切る (Sutherland-Hodgman)
+ * labels[i] は辺 (i, i + 1) の向こうの点で、切り口の辺には label を付ける。
+ */
+static void ClipHalfPlane(std::vector<Point2D>& points, std::vector<std::size_t>& labels, const Point2D& normal, const double offset, const std::size_t label)
+{
+    std::vector<Point2D> clipped_points;
+    std::vector<std::size_t> clipped_labels;
+    const std::size_t m = points.size();
+    for (std::size_t i = 0; i < m; i++)
+    {
+        const Point2D& s = points[i];
+        const Point2D& e = points[(i + 1) % m];
+        const double ds = dot(normal, s) - offset;
+        const double de = dot(normal, e) - offset;
+        if (ds <= 0)
+        {
+            clipped_points.push_back(s);
+            clipped_labels.push_back(labels[i]);
+            if (de > 0)
+            {
+                clipped_points.push_back(s + (e - s) * (ds / (ds - de)));
+                clipped_labels.push_back(label);
+            }
+        }
+        else if (de <= 0)
+        {
+            clipped_points.push_back(s + (e - s) * (ds / (ds - de)));
+            clipped_labels.push_back(labels[i]);
+        }
+    }
+    points.swap(clipped_points);
+    labels.swap(clipped_labels);
+}
+
+static void ClipBox(std::vector<Point2D>& points, std::vector<std::size_t>& labels, const Point2D& box_min, const Point2D& box_max)
+{
+    // ほとんどの領域は矩形の内側に収まっている
+    const bool inside = std::all_of(points.begin(), points.end(), [&](const Point2D& p) {
+        return box_min.x() <= p.x() && p.x() <= box_max.x() && box_min.y() <= p.y() && p.y() <= box_max.y();
+    });
+    if (inside)
+    {
+        return;
+    }
+    ClipHalfPlane(points, labels, Point2D({ 1.0, 0.0 }), box_max.x(), VoronoiDiagram::None());
+    ClipHalfPlane(points, labels, Point2D({ -1.0, 0.0 }), -box_min.x(), VoronoiDiagram::None());
+    ClipHalfPlane(points, labels, Point2D({ 0.0, 1.0 }), box_max.y(), VoronoiDiagram::None());
+    ClipHalfPlane(points, labels, Point2D({ 0.0, -1.0 }), -box_min.y(), VoronoiDiagram::None());
+}
+
+// 辺 from -> to の右側 (凸包なら外側) を向く単位法線
+static Point2D RightNormal(const Point2D& from, const Point2D& to)
+{
+    const Point2D d = to - from;
+    return Point2D({ d.y(), -d.x() }) / std::sqrt(d.Norm2());
+}
+
+VoronoiDiagram::VoronoiDiagram(const std::vector<Point2D>& position_list, const TriangleMesh& mesh, const Point2D& box_min, const Point2D& box_max)
+    : position_list_(position_list)
+{
+    Build(mesh, box_min, box_max);
+}
+
+VoronoiDiagram::VoronoiDiagram(const std::vector<Point2D>& position_list, const Point2D& box_min, const Point2D& box_max)
+    : position_list_(position_list)
+{
+    Build(GetDelaunayMesh(position_list), box_min, box_max);
+}
+
+std::size_t VoronoiDiagram::Locate(const Point2D& p, std::size_t hint) const noexcept
+{
+    if (size() == 0)
+    {
+        return None();
+    }
+    // 同じ座標の点 (領域が空) からは歩けない
+    for (std::size_t i = 0; i < size() && CellSize(hint) == 0; i++)
+    {
+        hint = (hint + 1) % size();
+    }
+
+    std::size_t current = hint;
+    double current_distance = (position_list_[current] - p).Norm2();
+    while (true)
+    {
+        std::size_t next = current;
+        for (std::size_t j = 0; j < CellSize(current); j++)
+        {
+            const std::size_t neighbor = CellNeighbor(current, j);
+            if (neighbor == None())
+            {
+                continue;
+            }
+            const double distance = (position_list_[neighbor] - p).Norm2();
+            if (distance < current_distance)
+            {
+                next = neighbor;
+                current_distance = distance;
+            }
+        }
+        if (next == current)
+        {
+            return current;
+        }
+        current = next;
+    }
+}
+
+void VoronoiDiagram::Build(const TriangleMesh& mesh, const Point2D& box_min, const Point2D& box_max)
+{
+    if (mesh.TriangleSize() == 0)
+    {
+        BuildCollinear(box_min, box_max);
+        return;
+    }
+
+    const auto pos = [&](const std::size_t i) -> const Point2D& {
+        return position_list_[i];
+    };
+
+    vertices_.reserve(mesh.TriangleSize());
+    for (std::size_t t = 0; t < mesh.TriangleSize(); t++)
+    {
+        vertices_.push_back(Triangle2D::GetCircumscribedCircle(pos(mesh.Vertex(t, 0)), pos(mesh.Vertex(t, 1)), pos(mesh.Vertex(t, 2))).Center());
+    }
+
+    // 点から出る half-edge。凸包上の点は凸包の辺 (周りを反時計回りに回ったときの最初の辺) にする
+    std::vector<std::size_t> start(size(), None());
+    for (std::size_t e = 0; e < mesh.Triangles().size(); e++)
+    {
+        if (start[mesh.Origin(e)] == None() || mesh.Twin(e) == TriangleMesh::None())
+        {
+            start[mesh.Origin(e)] = e;
+        }
+    }
+
+    const Point2D center = (box_min + box_max) / 2.0;
+    const double diagonal = std::sqrt((box_max - box_min).Norm2());
+
+    std::vector<Point2D> points;
+    std::vector<std::size_t> labels;
+    cell_offsets_.reserve(size() + 1);
+    cell_points_.reserve(mesh.Triangles().size() + 3 * mesh.Hull().size());
+    cell_neighbors_.reserve(mesh.Triangles().size() + 3 * mesh.Hull().size());
+    cell_offsets_.push_back(0);
+    for (std::size_t v = 0; v < size(); v++)
+    {
+        points.clear();
+        labels.clear();
+        if (start[v] == None())
+        {
+            cell_offsets_.push_back(cell_points_.size());
+            continue;
+        }
+
+        // v の周りの三角形を反時計回りに回る。外心 j と j + 1 の間の辺は、2 つの三角形が共有する辺の双対
+        const std::size_t first = start[v];
+        std::size_t e = first;
+        bool on_hull = false;
+        while (true)
+        {
+            points.push_back(vertices_[e / 3]);
+            const std::size_t prev = TriangleMesh::Prev(e);
+            labels.push_back(mesh.Origin(prev));
+            const std::size_t next = mesh.Twin(prev);
+            if (next == TriangleMesh::None())
+            {
+                on_hull = true;
+                break;
+            }
+            e = next;
+            if (e == first)
+            {
+                break;
+            }
+        }
+
+        if (on_hull)
+        {
+            // 両端の外心から凸包の外へ伸びる半直線を、矩形に掛からないほど遠くで打ち切る
+            const std::size_t w = mesh.Target(first);
+            const std::size_t u = labels.back();
+            const Point2D first_normal = RightNormal(pos(v), pos(w));
+            const Point2D last_normal = RightNormal(pos(u), pos(v));
+
+            Point2D middle = (pos(v) - pos(u)) / std::sqrt((pos(v) - pos(u)).Norm2()) + (pos(v) - pos(w)) / std::sqrt((pos(v) - pos(w)).Norm2());
+            const double middle_norm = std::sqrt(middle.Norm2());
+            middle = middle_norm > 1e-12 ? middle / middle_norm : first_normal;
+
+            const double reach = std::max({ std::sqrt((points.front() - center).Norm2()), std::sqrt((points.back() - center).Norm2()), std::sqrt((pos(v) - center).Norm2()) });
+            const double length = 2.0 * (diagonal + reach);
+
+            const Point2D first_far = points.front() + first_normal * length;
+            const Point2D last_far = points.back() + last_normal * length;
+            points.insert(points.begin(), first_far);
+            labels.insert(labels.begin(), w);
+            points.push_back(last_far);
+            labels.push_back(None());
+            points.push_back(pos(v) + middle * length);
+            labels.push_back(None());
+        }
+
+        ClipBox(points, labels, box_min, box_max);
+        cell_points_.insert(cell_points_.end(), points.begin(), points.end());
+        cell_neighbors_.insert(cell_neighbors_.end(), labels.begin(), labels.end());
+        cell_offsets_.push_back(cell_points_.size());
+    }
+}
+
+/**
+ * @brief 三角形がないとき。点を辞書順に並べ、前後の点との垂直二等分線で矩形を切る
+ */
+void VoronoiDiagram::BuildCollinear(const Point2D& box_min, const Point2D& box_max)
+{
+    std::vector<std::size_t> order(size());
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](const std::size_t i, const std::size_t j) {
+        const Point2D& p = position_list_[i];
+        const Point2D& q = position_list_[j];
+        return std::make_tuple(p.x(), p.y(), i) < std::make_tuple(q.x(), q.y(), j);
+    });
+    std::vector<std::size_t> sites;
+    for (const auto i : order)
+    {
+        if (sites.empty() || (position_list_[sites.back()] - position_list_[i]).Norm2() > 0)
+        {
+            sites.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<Point2D>> cell_points(size());
+    std::vector<std::vector<std::size_t>> cell_labels(size());
+    for (std::size_t k = 0; k < sites.size(); k++)
+    {
+        auto& points = cell_points[sites[k]];
+        auto& labels = cell_labels[sites[k]];
+        points = { box_min, Point2D({ box_max.x(), box_min.y() }), box_max, Point2D({ box_min.x(), box_max.y() }) };
+        labels.assign(4, None());
+
+        const Point2D& v = position_list_[sites[k]];
+        for (const std::size_t l : { k - 1, k + 1 })
+        {
+            if (l >= sites.size())
+            {
+                continue;
+            }
+            const Point2D& u = position_list_[sites[l]];
+            ClipHalfPlane(points, labels, u - v, (u.Norm2() - v.Norm2()) / 2.0, sites[l]);
+        }
+    }
+
+    cell_offsets_.push_back(0);
+    for (std::size_t i = 0; i < size(); i++)
+    {
+        cell_points_.insert(cell_points_.end(), cell_points[i].begin(), cell_points[i].end());
+        cell_neighbors_.insert(cell_neighbors_.end(), cell_labels[i].begin(), cell_labels[i].end());
+        cell_offsets_.push_back(cell_points_.size());
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "geometry/base.hpp"
+#include "geometry/triangle_mesh.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Delaunay 三角形分割の双対として作る、矩形で切り取った Voronoi 図 (O(n))
+ * 点 i の領域は、i の周りの三角形の外心を反時計回りに繋いだ凸多角形を矩形 [box_min, box_max] で切ったもの。
+ * 凸包上の点の領域は外向きの半直線を十分遠くで打ち切ってから切る。
+ * 一直線上の点しかないときは、隣の点との垂直二等分線で矩形を切る。
+ *
+ * 領域の頂点は CellVertex(i, 0..CellSize(i)) に反時計回りに並び、辺 (j, j + 1) の向こうの点は CellNeighbor(i, j)
+ * (矩形の辺なら None())。同じ座標の点は 2 つ目以降の領域を空にする。
+ */
+class VoronoiDiagram
+{
+public:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    /**
+     * @param mesh position_list の Delaunay 三角形分割 (GetDelaunayMesh の結果)
+     */
+    VoronoiDiagram(const std::vector<Point2D>& position_list, const TriangleMesh& mesh, const Point2D& box_min, const Point2D& box_max);
+
+    // 三角形分割も作る
+    VoronoiDiagram(const std::vector<Point2D>& position_list, const Point2D& box_min, const Point2D& box_max);
+
+    // 点の数
+    std::size_t size() const noexcept
+    {
+        return position_list_.size();
+    }
+
+    /**
+     * @brief Voronoi 頂点 (三角形 t の外心)。矩形の外にあるものも含む
+     */
+    const std::vector<Point2D>& Vertices() const noexcept
+    {
+        return vertices_;
+    }
+
+    std::size_t CellSize(const std::size_t i) const noexcept
+    {
+        return cell_offsets_[i + 1] - cell_offsets_[i];
+    }
+
+    const Point2D& CellVertex(const std::size_t i, const std::size_t j) const noexcept
+    {
+        return cell_points_[cell_offsets_[i] + j];
+    }
+
+    std::size_t CellNeighbor(const std::size_t i, const std::size_t j) const noexcept
+    {
+        return cell_neighbors_[cell_offsets_[i] + j];
+    }
+
+    /**
+     * @brief p を領域に含む点 (最も近い点) を、hint から近い隣の領域へ移りながら探す
+     * 点と p が矩形の中にあれば、矩形の中で接する領域だけを辿っても最も近い点に着く。
+     */
+    std::size_t Locate(const Point2D& p, std::size_t hint = 0) const noexcept;
+
+private:
+    std::vector<Point2D> position_list_;
+
+    std::vector<Point2D> vertices_;
+
+    // 点 i の領域は [cell_offsets_[i], cell_offsets_[i + 1])
+    std::vector<std::size_t> cell_offsets_;
+    std::vector<Point2D> cell_points_;
+    std::vector<std::size_t> cell_neighbors_;
+
+    void Build(const TriangleMesh& mesh, const Point2D& box_min, const Point2D& box_max);
+    void BuildCollinear(const Point2D& box_min, const Point2D& box_max);
+};
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "../thread/thread_pool.hpp"
+#include "base.hpp"
+#include "shortest_path.hpp"
+
+// 行の先頭をキャッシュライン境界に揃えるための allocator
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(const std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, const std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief 全点対距離を 1 本の連続領域に行優先で持つ行列
+ * 行の長さは BlockSize の倍数に切り上げ、はみ出した部分は Infinity() で埋める。
+ * d[i][j] で i -> j の距離を読み書きできる。
+ *
+ * @tparam T distance type
+ */
+template <typename T>
+class DistanceMatrix
+{
+public:
+    static constexpr std::size_t BlockSize = 64;
+
+    /**
+     * @brief 到達できないことを表す値。整数型では max / 2 なので、有限値 2 つの和は溢れない
+     */
+    static constexpr T Infinity()
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max() / 2;
+    }
+
+    explicit DistanceMatrix(const std::size_t n)
+        : size_(n)
+        , stride_((n + BlockSize - 1) / BlockSize * BlockSize)
+        , data_(stride_ * stride_, Infinity())
+    {
+        for (std::size_t i = 0; i < size_; i++)
+        {
+            data_[i * stride_ + i] = 0;
+        }
+    }
+
+    T* operator[](const std::size_t i) noexcept
+    {
+        return data_.data() + i * stride_;
+    }
+
+    const T* operator[](const std::size_t i) const noexcept
+    {
+        return data_.data() + i * stride_;
+    }
+
+    bool reachable(const std::size_t i, const std::size_t j) const noexcept
+    {
+        return (*this)[i][j] != Infinity();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // 1 行の要素数 (BlockSize の倍数)
+    std::size_t stride() const noexcept
+    {
+        return stride_;
+    }
+
+    T* data() noexcept
+    {
+        return data_.data();
+    }
+
+    const T* data() const noexcept
+    {
+        return data_.data();
+    }
+
+private:
+    std::size_t size_;
+    std::size_t stride_;
+    std::vector<T, AlignedAllocator<T>> data_;
+};
+
+/**
+ * @brief グラフの辺で初期化した距離行列 (多重辺は最小の重み、自己ループは無視)
+ */
+template <typename T, typename GraphType>
+DistanceMatrix<T> make_distance_matrix(const GraphType& graph)
+{
+    DistanceMatrix<T> distance(graph.size());
+    for (std::size_t i = 0; i < graph.size(); i++)
+    {
+        T* row = distance[i];
+        for (const auto& adj : graph.adjacent(i))
+        {
+            if (adj.first != i)
+            {
+                row[adj.first] = std::min(row[adj.first], static_cast<T>(graph.edge_at(adj.second)));
+            }
+        }
+    }
+    return distance;
+}
+
+/**
+ * @brief c[i][j] = min(c[i][j], a[i][k] + b[k][j]) を k = 0, 1, ... の順に BlockSize 四方のブロックで行う
+ * c が a や b と同じブロックでも正しく動く (対角が 0 以上であれば、k 行 / k 列は更新されない)。
+ * 内側のループは行の連続領域に対する min-plus なので、コンパイラがベクトル化する。
+ */
+template <typename T>
+void min_plus_block(T* c, const T* a, const T* b, const std::size_t stride) noexcept
+{
+    constexpr std::size_t B = DistanceMatrix<T>::BlockSize;
+    constexpr T inf = DistanceMatrix<T>::Infinity();
+
+    for (std::size_t k = 0; k < B; k++)
+    {
+        const T* bk = b + k * stride;
+        for (std::size_t i = 0; i < B; i++)
+        {
+            const T aik = a[i * stride + k];
+            if (aik == inf)
+            {
+                continue;
+            }
+            T* ci = c + i * stride;
+#pragma GCC ivdep
+            for (std::size_t j = 0; j < B; j++)
+            {
+                const T via = bk[j] == inf ? inf : aik + bk[j];
+                ci[j] = ci[j] < via ? ci[j] : via;
+            }
+        }
+    }
+}
+
+/**
+ * @brief ブロック化した Warshall-Floyd (in-place)
+ * k ブロックごとに 対角ブロック -> k 行 / k 列のブロック -> 残りのブロック の順に更新する。
+ * 3 ブロック分の作業領域が L1/L2 に収まるので、素朴な三重ループよりキャッシュミスが少ない。
+ * 負閉路は扱わない。
+ */
+template <typename T>
+void warshall_floyd(DistanceMatrix<T>& distance)
+{
+    constexpr std::size_t B = DistanceMatrix<T>::BlockSize;
+    const std::size_t stride = distance.stride();
+    const std::size_t blocks = stride / B;
+    auto block = [&](const std::size_t bi, const std::size_t bj) {
+        return distance.data() + bi * B * stride + bj * B;
+    };
+
+    for (std::size_t kb = 0; kb < blocks; kb++)
+    {
+        T* diagonal = block(kb, kb);
+        min_plus_block(diagonal, diagonal, diagonal, stride);
+
+        for (std::size_t b = 0; b < blocks; b++)
+        {
+            if (b != kb)
+            {
+                min_plus_block(block(kb, b), diagonal, block(kb, b), stride);
+                min_plus_block(block(b, kb), block(b, kb), diagonal, stride);
+            }
+        }
+
+        for (std::size_t bi = 0; bi < blocks; bi++)
+        {
+            if (bi == kb)
+            {
+                continue;
+            }
+            for (std::size_t bj = 0; bj < blocks; bj++)
+            {
+                if (bj != kb)
+                {
+                    min_plus_block(block(bi, bj), block(bi, kb), block(kb, bj), stride);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 重みの型 T で全点対最短路を求める
+ * 例: auto d = all_pairs_shortest_path<std::int32_t>(graph); d[i][j]
+ */
+template <typename T, typename GraphType>
+DistanceMatrix<T> all_pairs_shortest_path(const GraphType& graph)
+{
+    auto distance = make_distance_matrix<T>(graph);
+    warshall_floyd(distance);
+    return distance;
+}
+
+/**
+ * @brief ブロック化した Warshall-Floyd をスレッドプールで並列に行う
+ * 各 k ブロックの中で、k 行 / k 列のブロック同士、残りのブロック同士はそれぞれ独立なので並列に更新する。
+ */
+template <typename T>
+void warshall_floyd(DistanceMatrix<T>& distance, ThreadPool& pool)
+{
+    constexpr std::size_t B = DistanceMatrix<T>::BlockSize;
+    const std::size_t stride = distance.stride();
+    const std::size_t blocks = stride / B;
+    auto block = [&](const std::size_t bi, const std::size_t bj) {
+        return distance.data() + bi * B * stride + bj * B;
+    };
+
+    for (std::size_t kb = 0; kb < blocks; kb++)
+    {
+        T* diagonal = block(kb, kb);
+        min_plus_block(diagonal, diagonal, diagonal, stride);
+
+        pool.parallel_for(0, 2 * blocks, [&](const std::size_t i) {
+            const std::size_t b = i / 2;
+            if (b == kb)
+            {
+                return;
+            }
+            if (i % 2 == 0)
+            {
+                min_plus_block(block(kb, b), diagonal, block(kb, b), stride);
+            }
+            else
+            {
+                min_plus_block(block(b, kb), block(b, kb), diagonal, stride);
+            }
+        });
+
+        pool.parallel_for(0, blocks * blocks, [&](const std::size_t i) {
+            const std::size_t bi = i / blocks;
+            const std::size_t bj = i % blocks;
+            if (bi != kb && bj != kb)
+            {
+                min_plus_block(block(bi, bj), block(bi, kb), block(kb, bj), stride);
+            }
+        });
+    }
+}
+
+template <typename T, typename GraphType>
+DistanceMatrix<T> all_pairs_shortest_path(const GraphType& graph, ThreadPool& pool)
+{
+    auto distance = make_distance_matrix<T>(graph);
+    warshall_floyd(distance, pool);
+    return distance;
+}
+
+/**
+ * @brief 始点ごとの Dijkstra を並列に行う全点対最短路 (重みは非負)
+ * 疎なグラフでは Warshall-Floyd の O(V^3) より速い。隣接を連続に持つ CSRGraph で使うのがよい。
+ *
+ * @tparam T distance type
+ * @tparam Queue Dijkstra のキュー (shortest_path.hpp)
+ */
+template <typename T, template <typename> class Queue = BinaryHeapQueue, typename GraphType>
+DistanceMatrix<T> all_pairs_dijkstra(const GraphType& graph, ThreadPool& pool)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    const std::size_t n = graph.size();
+    DistanceMatrix<T> distance(n);
+
+    // 塊ごとにキューと結果の領域を使い回す
+    const std::size_t chunks = std::min(n, pool.concurrency() * 4);
+    const std::size_t chunk_size = chunks == 0 ? 0 : (n + chunks - 1) / chunks;
+    pool.parallel_for(0, chunks, [&](const std::size_t chunk) {
+        ShortestPathTree<CostType> tree;
+        Queue<CostType> que;
+        const std::size_t last = std::min(n, (chunk + 1) * chunk_size);
+        for (std::size_t s = chunk * chunk_size; s < last; s++)
+        {
+            dijkstra(graph, s, ShortestPathTree<CostType>::None(), que, tree);
+            T* row = distance[s];
+            for (std::size_t v = 0; v < n; v++)
+            {
+                row[v] = tree.reachable(v) ? static_cast<T>(tree.distance[v]) : DistanceMatrix<T>::Infinity();
+            }
+        }
+    });
+    return distance;
+}
@@ -1,19 +1,146 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <map>
+#include <iterator>
+#include <ostream>
 #include <queue>
-#include <unordered_set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+// [begin, end) を range-based for で回すための薄いラッパ
+template <typename Iterator>
+class Range
+{
+public:
+    Range(Iterator first, Iterator last) noexcept
+        : begin_(first)
+        , end_(last)
+    {
+    }
+
+    Iterator begin() const noexcept
+    {
+        return begin_;
+    }
+
+    Iterator end() const noexcept
+    {
+        return end_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return std::distance(begin_, end_);
+    }
+
+    bool empty() const noexcept
+    {
+        return begin_ == end_;
+    }
+
+private:
+    Iterator begin_;
+    Iterator end_;
+};
+
+// (key, value) の列から key だけを列挙する view
+// 隣接リスト (行き先, 辺番号) を、行き先の列として見せるのに使う
+template <typename Container>
+class KeyView
+{
+public:
+    class iterator
+    {
+    public:
+        using BaseIterator = typename Container::const_iterator;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type::first_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        explicit iterator(BaseIterator it) noexcept
+            : it_(it)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return it_->first;
+        }
+
+        iterator& operator++() noexcept
+        {
+            ++it_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator ret(*this);
+            ++it_;
+            return ret;
+        }
+
+        bool operator==(const iterator& another) const noexcept
+        {
+            return it_ == another.it_;
+        }
+
+        bool operator!=(const iterator& another) const noexcept
+        {
+            return it_ != another.it_;
+        }
+
+    private:
+        BaseIterator it_;
+    };
+
+    explicit KeyView(const Container& container) noexcept
+        : container_(&container)
+    {
+    }
+
+    iterator begin() const noexcept
+    {
+        return iterator(container_->begin());
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator(container_->end());
+    }
+
+    std::size_t size() const noexcept
+    {
+        return container_->size();
+    }
+
+    bool empty() const noexcept
+    {
+        return container_->empty();
+    }
+
+private:
+    const Container* container_;
+};
+
+/**
+ * @brief 隣接リストをハッシュで持つグラフ
+ * 重みは辺番号で引く平坦な配列に置き、adjacent() で (行き先, 辺番号) を列挙できる。
+ * 無向グラフでは両方向が同じ辺番号を共有する。
+ */
 template <typename N = std::size_t, typename E = std::size_t>
 class SparseGraph
 {
 public:
     using NodeType = N;
     using EdgeType = E;
-    using NeighborListType = std::unordered_set<std::size_t>;
+    using AdjacencyListType = std::unordered_map<std::size_t, std::size_t>;
+    using NeighborListType = KeyView<AdjacencyListType>;
 
     SparseGraph(bool undirected = true) noexcept
         : undirected_(undirected)
@@ -23,36 +150,39 @@ public:
     void push_node(NodeType n) noexcept
     {
         nodes_.push_back(n);
-        neighbor_list_.emplace_back();
+        adjacency_list_.emplace_back();
     }
 
     void connect(const std::size_t from, const std::size_t to, const EdgeType edge = EdgeType()) noexcept
     {
-        if (undirected_)
+        const auto it = adjacency_list_[from].find(to);
+        if (it != adjacency_list_[from].end())
         {
-            neighbor_list_[from].insert(to);
-            neighbor_list_[to].insert(from);
-            edges_[std::make_pair(std::min(from, to), std::max(from, to))] = edge;
+            edges_[it->second] = edge;
+            return;
         }
-        else
+
+        const std::size_t id = new_edge(edge);
+        adjacency_list_[from].emplace(to, id);
+        if (undirected_)
         {
-            neighbor_list_[from].insert(to);
-            edges_[std::make_pair(from, to)] = edge;
+            adjacency_list_[to].emplace(from, id);
         }
     }
 
     void disconnect(const std::size_t from, const std::size_t to) noexcept
     {
-        if (undirected_)
+        const auto it = adjacency_list_[from].find(to);
+        if (it == adjacency_list_[from].end())
         {
-            neighbor_list_[from].erase(to);
-            neighbor_list_[to].erase(from);
-            edges_.erase(std::make_pair(std::min(from, to), std::max(from, to)));
+            return;
         }
-        else
+
+        free_edge_ids_.push_back(it->second);
+        adjacency_list_[from].erase(it);
+        if (undirected_)
         {
-            neighbor_list_[from].erase(to);
-            edges_.erase(std::make_pair(from, to));
+            adjacency_list_[to].erase(from);
         }
     }
 
@@ -68,47 +198,51 @@ public:
 
     const EdgeType& edge(const std::size_t from, const std::size_t to) const noexcept
     {
-        if (undirected_)
-        {
-            auto key = std::make_pair(std::min(from, to), std::max(from, to));
-            return edges_.at(key);
-        }
-        else
-        {
-            auto key = std::make_pair(from, to);
-            return edges_.at(key);
-        }
+        return edges_[adjacency_list_[from].at(to)];
     }
 
     EdgeType& edge(const std::size_t from, const std::size_t to) noexcept
     {
-        if (undirected_)
-        {
-            auto key = std::make_pair(std::min(from, to), std::max(from, to));
-            return edges_.at(key);
-        }
-        else
-        {
-            auto key = std::make_pair(from, to);
-            return edges_.at(key);
-        }
+        return edges_[adjacency_list_[from].at(to)];
+    }
+
+    const EdgeType& edge_at(const std::size_t id) const noexcept
+    {
+        return edges_[id];
+    }
+
+    EdgeType& edge_at(const std::size_t id) noexcept
+    {
+        return edges_[id];
     }
 
-    const NeighborListType&
-    neighbor(const std::size_t index) const noexcept
+    NeighborListType neighbor(const std::size_t index) const noexcept
     {
-        return neighbor_list_[index];
+        return NeighborListType(adjacency_list_[index]);
+    }
+
+    /**
+     * @brief (行き先, 辺番号) の列。重みは edge_at(辺番号) で O(1) に読み書きできる
+     */
+    const AdjacencyListType& adjacent(const std::size_t index) const noexcept
+    {
+        return adjacency_list_[index];
     }
 
     std::size_t size() const noexcept
     {
-        return neighbor_list_.size();
+        return adjacency_list_.size();
+    }
+
+    bool undirected() const noexcept
+    {
+        return undirected_;
     }
 
     SparseGraph<N, E> decide_root(const int node_index) const noexcept
     {
         SparseGraph<N, E> graph(false);
-        for (int i = 0; i < nodes_.size(); i++)
+        for (std::size_t i = 0; i < nodes_.size(); i++)
         {
             graph.push_node(node(i));
         }
@@ -116,17 +250,18 @@ public:
         std::queue<int> que;
         que.push(node_index);
         std::vector<bool> visited(size(), false);
-        visited[node_index] = false;
+        visited[node_index] = true;
 
         while (!que.empty())
         {
             const int node = que.front();
             que.pop();
-            for (auto next : neighbor(node))
+            for (const auto& adj : adjacent(node))
             {
+                const auto next = adj.first;
                 if (!visited[next])
                 {
-                    graph.connect(node, next, edge(node, next));
+                    graph.connect(node, next, edge_at(adj.second));
                     visited[next] = true;
                     que.push(next);
                 }
@@ -136,24 +271,43 @@ public:
     }
 
 private:
-    using EdgeMap = std::map<std::pair<std::size_t, std::size_t>, EdgeType>;
+    std::size_t new_edge(const EdgeType& edge) noexcept
+    {
+        if (free_edge_ids_.empty())
+        {
+            edges_.push_back(edge);
+            return edges_.size() - 1;
+        }
+        const std::size_t id = free_edge_ids_.back();
+        free_edge_ids_.pop_back();
+        edges_[id] = edge;
+        return id;
+    }
 
-    std::vector<NeighborListType> neighbor_list_;
+    std::vector<AdjacencyListType> adjacency_list_;
 
-    EdgeMap edges_;
+    std::vector<EdgeType> edges_;
+
+    // disconnect で空いた辺番号
+    std::vector<std::size_t> free_edge_ids_;
 
     std::vector<NodeType> nodes_;
 
     bool undirected_;
 };
 
+/**
+ * @brief 隣接リストを連続配列で持つグラフ。多重辺を許す
+ * edge(from, to) は隣接リストの線形探索なので、重みは adjacent() 経由で読むこと。
+ */
 template <typename N = std::size_t, typename E = std::size_t>
 class DenseGraph
 {
 public:
     using NodeType = N;
     using EdgeType = E;
-    using NeighborListType = std::vector<std::size_t>;
+    using AdjacencyListType = std::vector<std::pair<std::size_t, std::size_t>>;
+    using NeighborListType = KeyView<AdjacencyListType>;
 
     DenseGraph(bool undirected = true) noexcept
         : undirected_(undirected)
@@ -163,44 +317,37 @@ public:
     void push_node(NodeType n) noexcept
     {
         nodes_.push_back(n);
-        neighbor_list_.emplace_back();
+        adjacency_list_.emplace_back();
     }
 
     void connect(const std::size_t from, const std::size_t to, const EdgeType edge) noexcept
     {
         const std::size_t new_size = std::max(from, to) + 1;
 
-        if (neighbor_list_.size() < new_size)
+        if (adjacency_list_.size() < new_size)
         {
-            neighbor_list_.resize(new_size);
+            adjacency_list_.resize(new_size);
             nodes_.resize(new_size);
         }
 
+        const std::size_t id = new_edge(edge);
+        adjacency_list_[from].emplace_back(to, id);
         if (undirected_)
         {
-            neighbor_list_[from].push_back(to);
-            neighbor_list_[to].push_back(from);
-            edges_[std::make_pair(std::min(from, to), std::max(from, to))] = edge;
-        }
-        else
-        {
-            neighbor_list_[from].push_back(to);
-            edges_[std::make_pair(from, to)] = edge;
+            adjacency_list_[to].emplace_back(from, id);
         }
     }
 
     void disconnect(const std::size_t from, const std::size_t to) noexcept
     {
+        auto& from_list = adjacency_list_[from];
+        const auto it = find(from_list, to);
+        free_edge_ids_.push_back(it->second);
+        from_list.erase(it);
         if (undirected_)
         {
-            neighbor_list_[from].erase(std::find(neighbor_list_[from].begin(), neighbor_list_[from].end(), to));
-            neighbor_list_[to].erase(std::find(neighbor_list_[to].begin(), neighbor_list_[to].end(), from));
-            edges_.erase(std::make_pair(std::min(from, to), std::max(from, to)));
-        }
-        else
-        {
-            neighbor_list_[from].erase(std::find(neighbor_list_[from].begin(), neighbor_list_[from].end(), to));
-            edges_.erase(std::make_pair(from, to));
+            auto& to_list = adjacency_list_[to];
+            to_list.erase(find(to_list, from));
         }
     }
 
@@ -211,35 +358,77 @@ public:
 
     const EdgeType& edge(const std::size_t from, const std::size_t to) const noexcept
     {
-        if (undirected_)
-        {
-            auto key = std::make_pair(std::min(from, to), std::max(from, to));
-            return edges_.at(key);
-        }
-        else
-        {
-            auto key = std::make_pair(from, to);
-            return edges_.at(key);
-        }
+        return edges_[find(adjacency_list_[from], to)->second];
+    }
+
+    EdgeType& edge(const std::size_t from, const std::size_t to) noexcept
+    {
+        return edges_[find(adjacency_list_[from], to)->second];
+    }
+
+    const EdgeType& edge_at(const std::size_t id) const noexcept
+    {
+        return edges_[id];
+    }
+
+    EdgeType& edge_at(const std::size_t id) noexcept
+    {
+        return edges_[id];
+    }
+
+    NeighborListType neighbor(const std::size_t index) const noexcept
+    {
+        return NeighborListType(adjacency_list_[index]);
     }
 
-    const NeighborListType&
-    neighbor(const std::size_t index) const noexcept
+    /**
+     * @brief (行き先, 辺番号) の列。重みは edge_at(辺番号) で O(1) に読み書きできる
+     */
+    const AdjacencyListType& adjacent(const std::size_t index) const noexcept
     {
-        return neighbor_list_[index];
+        return adjacency_list_[index];
     }
 
     std::size_t size() const noexcept
     {
-        return neighbor_list_.size();
+        return adjacency_list_.size();
+    }
+
+    bool undirected() const noexcept
+    {
+        return undirected_;
     }
 
 private:
-    using EdgeMap = std::map<std::pair<std::size_t, std::size_t>, EdgeType>;
+    template <typename List>
+    static auto find(List& list, const std::size_t to) noexcept -> decltype(list.begin())
+    {
+        const auto it = std::find_if(list.begin(), list.end(), [to](const std::pair<std::size_t, std::size_t>& adj) {
+            return adj.first == to;
+        });
+        assert(it != list.end());
+        return it;
+    }
+
+    std::size_t new_edge(const EdgeType& edge) noexcept
+    {
+        if (free_edge_ids_.empty())
+        {
+            edges_.push_back(edge);
+            return edges_.size() - 1;
+        }
+        const std::size_t id = free_edge_ids_.back();
+        free_edge_ids_.pop_back();
+        edges_[id] = edge;
+        return id;
+    }
+
+    std::vector<AdjacencyListType> adjacency_list_;
 
-    std::vector<NeighborListType> neighbor_list_;
+    std::vector<EdgeType> edges_;
 
-    EdgeMap edges_;
+    // disconnect で空いた辺番号
+    std::vector<std::size_t> free_edge_ids_;
 
     std::vector<NodeType> nodes_;
 
@@ -0,0 +1,762 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <queue>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base.hpp"
+
+/**
+ * @brief Contraction Hierarchies の前処理結果
+ * 頂点を重要度の低い順に縮約してショートカット辺を足し、各頂点から順位の高い頂点への辺 (上向き辺) だけを残す。
+ * 内部の頂点番号は縮約の順位で、上向き辺は CSR で持つ。save / load でバイナリに書き出せる。
+ * 重みは非負とする。問い合わせは ContractionHierarchySearch で行う。
+ *
+ * @tparam CostType cost type
+ */
+template <typename CostType>
+class ContractionHierarchy
+{
+public:
+    static_assert(std::is_trivially_copyable<CostType>::value, "CostType must be trivially copyable");
+
+    static constexpr CostType Infinity()
+    {
+        return std::numeric_limits<CostType>::max();
+    }
+
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    // 上向き辺の CSR。順位 v からの辺は [offsets[v], offsets[v + 1])、行き先は昇順
+    struct UpwardGraph
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> targets;
+        std::vector<CostType> weights;
+
+        // ショートカットが迂回する頂点 (の順位)。元の辺なら None()
+        std::vector<std::size_t> middles;
+
+        std::size_t first_arc(const std::size_t v) const noexcept
+        {
+            return offsets[v];
+        }
+
+        std::size_t last_arc(const std::size_t v) const noexcept
+        {
+            return offsets[v + 1];
+        }
+
+        // v -> to の弧番号。なければ None()
+        std::size_t find(const std::size_t v, const std::size_t to) const noexcept
+        {
+            const auto first = targets.begin() + offsets[v];
+            const auto last = targets.begin() + offsets[v + 1];
+            const auto it = std::lower_bound(first, last, to);
+            return it != last && *it == to ? static_cast<std::size_t>(it - targets.begin()) : None();
+        }
+    };
+
+    ContractionHierarchy() = default;
+
+    /**
+     * @param witness_limit 縮約時の目撃路探索で確定させる頂点数の上限。小さいほど前処理は速いがショートカットが増える
+     */
+    template <typename GraphType>
+    explicit ContractionHierarchy(const GraphType& graph, const std::size_t witness_limit = 500)
+    {
+        build(graph, witness_limit);
+    }
+
+    template <typename GraphType>
+    void build(const GraphType& graph, const std::size_t witness_limit = 500)
+    {
+        Builder builder(graph, witness_limit);
+        builder.run(*this);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return order_.size();
+    }
+
+    // 元の頂点 v の縮約順位
+    std::size_t rank(const std::size_t v) const noexcept
+    {
+        return rank_[v];
+    }
+
+    // 順位 r の元の頂点
+    std::size_t vertex(const std::size_t r) const noexcept
+    {
+        return order_[r];
+    }
+
+    // 順位 v から順位の高い頂点への辺 (正方向探索用)
+    const UpwardGraph& forward() const noexcept
+    {
+        return forward_;
+    }
+
+    // 順位の高い頂点から順位 v への辺を逆向きに持ったもの (逆方向探索用)
+    const UpwardGraph& backward() const noexcept
+    {
+        return backward_;
+    }
+
+    // 前処理で足したショートカットの数
+    std::size_t shortcut_size() const noexcept
+    {
+        return shortcut_size_;
+    }
+
+    void save(std::ostream& out) const
+    {
+        write_value(out, Magic);
+        write_value(out, shortcut_size_);
+        write_vector(out, order_);
+        for (const UpwardGraph* g : {&forward_, &backward_})
+        {
+            write_vector(out, g->offsets);
+            write_vector(out, g->targets);
+            write_vector(out, g->weights);
+            write_vector(out, g->middles);
+        }
+    }
+
+    /**
+     * @brief save で書き出したものを読み込む。形式が合わなければ false
+     */
+    bool load(std::istream& in)
+    {
+        std::uint64_t magic = 0;
+        if (!read_value(in, magic) || magic != Magic)
+        {
+            return false;
+        }
+        bool ok = read_value(in, shortcut_size_) && read_vector(in, order_);
+        for (UpwardGraph* g : {&forward_, &backward_})
+        {
+            ok = ok && read_vector(in, g->offsets) && read_vector(in, g->targets) && read_vector(in, g->weights) && read_vector(in, g->middles);
+        }
+        if (!ok)
+        {
+            return false;
+        }
+
+        rank_.resize(order_.size());
+        for (std::size_t r = 0; r < order_.size(); r++)
+        {
+            rank_[order_[r]] = r;
+        }
+        return true;
+    }
+
+private:
+    // 形式の識別用 ("CHv1" + sizeof(CostType))
+    static constexpr std::uint64_t Magic = 0x43487631ull << 8 | sizeof(CostType);
+
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> rank_;
+    UpwardGraph forward_;
+    UpwardGraph backward_;
+    std::size_t shortcut_size_ = 0;
+
+    template <typename T>
+    static void write_value(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static void write_vector(std::ostream& out, const std::vector<T>& vec)
+    {
+        const std::uint64_t size = vec.size();
+        write_value(out, size);
+        out.write(reinterpret_cast<const char*>(vec.data()), sizeof(T) * vec.size());
+    }
+
+    template <typename T>
+    static bool read_value(std::istream& in, T& value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    template <typename T>
+    static bool read_vector(std::istream& in, std::vector<T>& vec)
+    {
+        std::uint64_t size = 0;
+        if (!read_value(in, size))
+        {
+            return false;
+        }
+        vec.resize(size);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(vec.data()), sizeof(T) * size));
+    }
+
+    // 縮約の作業用。縮約していない頂点の間の辺を入出力の両方向で持つ
+    class Builder
+    {
+    public:
+        template <typename GraphType>
+        Builder(const GraphType& graph, const std::size_t witness_limit)
+            : n_(graph.size())
+            , witness_limit_(witness_limit)
+            , out_(n_)
+            , in_(n_)
+            , contracted_(n_, false)
+            , deleted_neighbors_(n_, 0)
+            , priority_(n_, 0)
+            , distance_(n_, Infinity())
+            , target_(n_, false)
+        {
+            for (std::size_t v = 0; v < n_; v++)
+            {
+                for (const auto& adj : graph.adjacent(v))
+                {
+                    if (adj.first != v)
+                    {
+                        add_arc(v, adj.first, static_cast<CostType>(graph.edge_at(adj.second)), None());
+                    }
+                }
+            }
+        }
+
+        void run(ContractionHierarchy& ch)
+        {
+            using Element = std::pair<long long, std::size_t>;
+            std::priority_queue<Element, std::vector<Element>, std::greater<Element>> que;
+            for (std::size_t v = 0; v < n_; v++)
+            {
+                priority_[v] = compute_priority(v);
+                que.emplace(priority_[v], v);
+            }
+
+            std::vector<std::size_t> order;
+            order.reserve(n_);
+            std::vector<std::vector<Arc>> forward(n_);
+            std::vector<std::vector<Arc>> backward(n_);
+            std::size_t shortcuts = 0;
+
+            while (!que.empty())
+            {
+                const auto top = que.top();
+                que.pop();
+                const std::size_t v = top.second;
+                if (contracted_[v] || top.first != priority_[v])
+                {
+                    continue;
+                }
+
+                // lazy update: 取り出した時点で優先度を計算し直し、次の候補より悪ければ戻す
+                priority_[v] = compute_priority(v);
+                if (!que.empty() && priority_[v] > que.top().first)
+                {
+                    que.emplace(priority_[v], v);
+                    continue;
+                }
+
+                shortcuts += contract(v, false);
+                order.push_back(v);
+                contracted_[v] = true;
+                forward[v] = std::move(out_[v]);
+                backward[v] = std::move(in_[v]);
+
+                // 隣接頂点から v を外し、優先度を更新する
+                for (const auto& arc : forward[v])
+                {
+                    erase_arc(in_[arc.to], v);
+                    deleted_neighbors_[arc.to]++;
+                }
+                for (const auto& arc : backward[v])
+                {
+                    erase_arc(out_[arc.to], v);
+                    deleted_neighbors_[arc.to]++;
+                }
+                for (const auto* arcs : {&forward[v], &backward[v]})
+                {
+                    for (const auto& arc : *arcs)
+                    {
+                        const long long p = compute_priority(arc.to);
+                        if (p != priority_[arc.to])
+                        {
+                            priority_[arc.to] = p;
+                            que.emplace(p, arc.to);
+                        }
+                    }
+                }
+            }
+
+            ch.order_ = std::move(order);
+            ch.rank_.assign(n_, 0);
+            for (std::size_t r = 0; r < n_; r++)
+            {
+                ch.rank_[ch.order_[r]] = r;
+            }
+            ch.shortcut_size_ = shortcuts;
+            to_csr(ch, forward, ch.forward_);
+            to_csr(ch, backward, ch.backward_);
+        }
+
+    private:
+        struct Arc
+        {
+            std::size_t to;
+            CostType cost;
+            std::size_t middle;
+        };
+
+        std::size_t n_;
+        std::size_t witness_limit_;
+
+        std::vector<std::vector<Arc>> out_;
+        std::vector<std::vector<Arc>> in_;
+        std::vector<bool> contracted_;
+        std::vector<std::size_t> deleted_neighbors_;
+        std::vector<long long> priority_;
+
+        // 目撃路探索の作業領域。触った頂点だけを戻す
+        std::vector<CostType> distance_;
+        std::vector<std::size_t> touched_;
+        std::vector<std::pair<CostType, std::size_t>> heap_;
+
+        // 目撃路を探している頂点 (v の出辺の行き先)
+        std::vector<bool> target_;
+
+        // from -> to の辺を張る。既にあれば短い方を残す
+        void add_arc(const std::size_t from, const std::size_t to, const CostType cost, const std::size_t middle)
+        {
+            for (auto& arc : out_[from])
+            {
+                if (arc.to == to)
+                {
+                    if (cost < arc.cost)
+                    {
+                        arc.cost = cost;
+                        arc.middle = middle;
+                        for (auto& rev : in_[to])
+                        {
+                            if (rev.to == from)
+                            {
+                                rev.cost = cost;
+                                rev.middle = middle;
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            out_[from].push_back(Arc { to, cost, middle });
+            in_[to].push_back(Arc { from, cost, middle });
+        }
+
+        static void erase_arc(std::vector<Arc>& arcs, const std::size_t to)
+        {
+            for (std::size_t i = 0; i < arcs.size(); i++)
+            {
+                if (arcs[i].to == to)
+                {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+            }
+        }
+
+        // 優先度 = edge difference (足すショートカット数 - 消える辺数) + 縮約済みの隣接頂点数
+        long long compute_priority(const std::size_t v)
+        {
+            const long long added = static_cast<long long>(contract(v, true));
+            const long long removed = static_cast<long long>(out_[v].size() + in_[v].size());
+            return 2 * (added - removed) + static_cast<long long>(deleted_neighbors_[v]);
+        }
+
+        /**
+         * @brief v を縮約したときに必要なショートカットを数える。simulate = false なら実際に張る
+         * u -> v -> w より短いか等しい路 (目撃路) が v を通らずに見つからなければショートカット u -> w を張る。
+         */
+        std::size_t contract(const std::size_t v, const bool simulate)
+        {
+            std::size_t count = 0;
+            CostType max_out = 0;
+            for (const auto& arc : out_[v])
+            {
+                max_out = std::max(max_out, arc.cost);
+                target_[arc.to] = true;
+            }
+
+            // 探索中に in_[v] / out_[v] は変わらない (ショートカットは v に接続しない)
+            for (const auto& in_arc : in_[v])
+            {
+                const std::size_t u = in_arc.to;
+                witness_search(u, v, in_arc.cost + max_out, out_[v].size() - (target_[u] ? 1 : 0));
+                for (const auto& out_arc : out_[v])
+                {
+                    const std::size_t w = out_arc.to;
+                    if (w == u)
+                    {
+                        continue;
+                    }
+                    const CostType via = in_arc.cost + out_arc.cost;
+                    if (distance_[w] > via)
+                    {
+                        count++;
+                        if (!simulate)
+                        {
+                            add_arc(u, w, via, v);
+                        }
+                    }
+                }
+            }
+            for (const auto& arc : out_[v])
+            {
+                target_[arc.to] = false;
+            }
+            return count;
+        }
+
+        // v を通らない start からの Dijkstra。
+        // 行き先 targets 個を全て確定させるか、limit を超えるか、witness_limit_ 頂点確定したら打ち切る
+        void witness_search(const std::size_t start, const std::size_t v, const CostType limit, std::size_t targets)
+        {
+            for (auto u : touched_)
+            {
+                distance_[u] = Infinity();
+            }
+            touched_.clear();
+            heap_.clear();
+
+            const auto cmp = std::greater<std::pair<CostType, std::size_t>>();
+            distance_[start] = 0;
+            touched_.push_back(start);
+            heap_.emplace_back(0, start);
+            std::size_t settled = 0;
+            while (!heap_.empty() && settled < witness_limit_ && targets > 0)
+            {
+                std::pop_heap(heap_.begin(), heap_.end(), cmp);
+                const auto d = heap_.back().first;
+                const auto u = heap_.back().second;
+                heap_.pop_back();
+                if (distance_[u] < d)
+                {
+                    continue;
+                }
+                if (d > limit)
+                {
+                    break;
+                }
+                settled++;
+                if (target_[u] && u != start)
+                {
+                    targets--;
+                }
+
+                for (const auto& arc : out_[u])
+                {
+                    if (arc.to == v)
+                    {
+                        continue;
+                    }
+                    const CostType nd = d + arc.cost;
+                    if (nd < distance_[arc.to])
+                    {
+                        if (distance_[arc.to] == Infinity())
+                        {
+                            touched_.push_back(arc.to);
+                        }
+                        distance_[arc.to] = nd;
+                        heap_.emplace_back(nd, arc.to);
+                        std::push_heap(heap_.begin(), heap_.end(), cmp);
+                    }
+                }
+            }
+        }
+
+        // 縮約時に残っていた辺 (全て順位の高い頂点向き) を順位番号の CSR にする
+        void to_csr(const ContractionHierarchy& ch, const std::vector<std::vector<Arc>>& arcs, UpwardGraph& graph) const
+        {
+            graph.offsets.assign(n_ + 1, 0);
+            for (std::size_t r = 0; r < n_; r++)
+            {
+                graph.offsets[r + 1] = graph.offsets[r] + arcs[ch.order_[r]].size();
+            }
+            graph.targets.resize(graph.offsets[n_]);
+            graph.weights.resize(graph.offsets[n_]);
+            graph.middles.resize(graph.offsets[n_]);
+
+            std::vector<Arc> row;
+            for (std::size_t r = 0; r < n_; r++)
+            {
+                row = arcs[ch.order_[r]];
+                for (auto& arc : row)
+                {
+                    arc.to = ch.rank_[arc.to];
+                    arc.middle = arc.middle == None() ? None() : ch.rank_[arc.middle];
+                }
+                std::sort(row.begin(), row.end(), [](const Arc& a, const Arc& b) {
+                    return a.to < b.to;
+                });
+                std::size_t pos = graph.offsets[r];
+                for (const auto& arc : row)
+                {
+                    assert(arc.to > r);
+                    graph.targets[pos] = arc.to;
+                    graph.weights[pos] = arc.cost;
+                    graph.middles[pos] = arc.middle;
+                    pos++;
+                }
+            }
+        }
+    };
+};
+
+/**
+ * @brief ContractionHierarchy に対する 2 点間最短路の問い合わせ
+ * 始点からは forward、終点からは backward の上向き辺だけを辿る双方向 Dijkstra で、探索範囲は順位の高い少数の頂点に限られる。
+ * 作業領域は触った頂点だけを戻して使い回す。スレッドごとに 1 つ持てば並列に問い合わせられる。
+ *
+ * @tparam CostType cost type
+ */
+template <typename CostType>
+class ContractionHierarchySearch
+{
+public:
+    using HierarchyType = ContractionHierarchy<CostType>;
+
+    static constexpr CostType Infinity()
+    {
+        return HierarchyType::Infinity();
+    }
+
+    static constexpr std::size_t None()
+    {
+        return HierarchyType::None();
+    }
+
+    explicit ContractionHierarchySearch(const HierarchyType& hierarchy)
+        : hierarchy_(&hierarchy)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            distance_[side].assign(hierarchy.size(), Infinity());
+            parent_arc_[side].assign(hierarchy.size(), None());
+        }
+    }
+
+    /**
+     * @brief 元の頂点番号で start から goal までの最短距離。到達できなければ Infinity()
+     */
+    CostType distance(const std::size_t start, const std::size_t goal)
+    {
+        prepare();
+        const std::size_t s = hierarchy_->rank(start);
+        const std::size_t t = hierarchy_->rank(goal);
+        const typename HierarchyType::UpwardGraph* graphs[2] = { &hierarchy_->forward(), &hierarchy_->backward() };
+
+        touch(s);
+        distance_[0][s] = 0;
+        push(heap_[0], 0, s);
+        touch(t);
+        distance_[1][t] = 0;
+        push(heap_[1], 0, t);
+
+        CostType best = Infinity();
+        bool finished[2] = { false, false };
+        int side = 0;
+        while (!finished[0] || !finished[1])
+        {
+            // 暫定解以上のキーしか残っていない向きは終わり
+            if (heap_[side].empty() || heap_[side].front().first >= best)
+            {
+                finished[side] = true;
+                side = 1 - side;
+                continue;
+            }
+
+            CostType d;
+            std::size_t v;
+            std::tie(d, v) = pop(heap_[side]);
+            if (distance_[side][v] < d)
+            {
+                side = finished[1 - side] ? side : 1 - side;
+                continue;
+            }
+            settled_++;
+            if (distance_[1 - side][v] != Infinity() && d + distance_[1 - side][v] < best)
+            {
+                best = d + distance_[1 - side][v];
+                meet_ = v;
+            }
+
+            const auto& g = *graphs[side];
+            for (std::size_t e = g.first_arc(v); e < g.last_arc(v); e++)
+            {
+                const std::size_t nv = g.targets[e];
+                const CostType nd = d + g.weights[e];
+                if (nd < distance_[side][nv])
+                {
+                    touch(nv);
+                    distance_[side][nv] = nd;
+                    parent_arc_[side][nv] = e;
+                    push(heap_[side], nd, nv);
+                }
+            }
+            side = finished[1 - side] ? side : 1 - side;
+        }
+        return best;
+    }
+
+    /**
+     * @brief 直前の distance で見つけた最短路の (元の番号の) 頂点列。ショートカットは展開する。見つからなければ空
+     */
+    std::vector<std::size_t> path() const
+    {
+        std::vector<std::size_t> ret;
+        if (meet_ == None())
+        {
+            return ret;
+        }
+
+        const auto& forward = hierarchy_->forward();
+        const auto& backward = hierarchy_->backward();
+
+        // 始点 -> meet_ の上向き辺を逆順に集める
+        std::vector<std::pair<std::size_t, std::size_t>> arcs;
+        for (std::size_t v = meet_; parent_arc_[0][v] != None();)
+        {
+            const std::size_t e = parent_arc_[0][v];
+            const std::size_t u = std::upper_bound(forward.offsets.begin(), forward.offsets.end(), e) - forward.offsets.begin() - 1;
+            arcs.emplace_back(u, v);
+            v = u;
+        }
+        std::reverse(arcs.begin(), arcs.end());
+        // meet_ -> 終点 (backward の辺は逆向きに辿る)
+        for (std::size_t v = meet_; parent_arc_[1][v] != None();)
+        {
+            const std::size_t e = parent_arc_[1][v];
+            const std::size_t u = std::upper_bound(backward.offsets.begin(), backward.offsets.end(), e) - backward.offsets.begin() - 1;
+            arcs.emplace_back(v, u);
+            v = u;
+        }
+
+        ret.push_back(hierarchy_->vertex(arcs.empty() ? meet_ : arcs.front().first));
+        for (const auto& arc : arcs)
+        {
+            unpack(arc.first, arc.second, ret);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 直前の distance で確定した頂点の数
+     */
+    std::size_t settled() const noexcept
+    {
+        return settled_;
+    }
+
+private:
+    using HeapElement = std::pair<CostType, std::size_t>;
+
+    const HierarchyType* hierarchy_;
+
+    std::vector<CostType> distance_[2];
+
+    // 最短路木で各頂点に入る弧の番号
+    std::vector<std::size_t> parent_arc_[2];
+
+    std::vector<HeapElement> heap_[2];
+
+    std::vector<std::size_t> touched_;
+
+    std::size_t meet_ = None();
+    std::size_t settled_ = 0;
+
+    void prepare()
+    {
+        for (auto v : touched_)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                distance_[side][v] = Infinity();
+                parent_arc_[side][v] = None();
+            }
+        }
+        touched_.clear();
+        heap_[0].clear();
+        heap_[1].clear();
+        meet_ = None();
+        settled_ = 0;
+    }
+
+    void touch(const std::size_t v)
+    {
+        if (distance_[0][v] == Infinity() && distance_[1][v] == Infinity())
+        {
+            touched_.push_back(v);
+        }
+    }
+
+    // 順位 from -> to の辺 (ショートカットかもしれない) を展開し、from より後の頂点を out に足す
+    void unpack(const std::size_t from, const std::size_t to, std::vector<std::size_t>& out) const
+    {
+        const auto& forward = hierarchy_->forward();
+        const auto& backward = hierarchy_->backward();
+
+        // 展開待ちの辺のスタック。先頭側から順に出力する
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        stack.emplace_back(from, to);
+        while (!stack.empty())
+        {
+            const auto arc = stack.back();
+            stack.pop_back();
+
+            // 辺は順位の低い側の上向き辺として入っている
+            std::size_t middle;
+            if (arc.first < arc.second)
+            {
+                middle = forward.middles[forward.find(arc.first, arc.second)];
+            }
+            else
+            {
+                middle = backward.middles[backward.find(arc.second, arc.first)];
+            }
+
+            if (middle == None())
+            {
+                out.push_back(hierarchy_->vertex(arc.second));
+            }
+            else
+            {
+                stack.emplace_back(middle, arc.second);
+                stack.emplace_back(arc.first, middle);
+            }
+        }
+    }
+
+    static void push(std::vector<HeapElement>& heap, const CostType key, const std::size_t v)
+    {
+        heap.emplace_back(key, v);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapElement>());
+    }
+
+    static HeapElement pop(std::vector<HeapElement>& heap)
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapElement>());
+        const auto ret = heap.back();
+        heap.pop_back();
+        return ret;
+    }
+};
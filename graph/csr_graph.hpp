@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base.hpp"
+
+// CSR の隣接リストを (行き先, 辺番号) として列挙する iterator。辺番号は targets 上の位置
+class CSRAdjacencyIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<std::size_t, std::size_t>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    CSRAdjacencyIterator(const std::size_t* targets, const std::size_t id) noexcept
+        : targets_(targets)
+        , id_(id)
+    {
+    }
+
+    value_type operator*() const noexcept
+    {
+        return value_type(targets_[id_], id_);
+    }
+
+    CSRAdjacencyIterator& operator++() noexcept
+    {
+        ++id_;
+        return *this;
+    }
+
+    CSRAdjacencyIterator operator++(int) noexcept
+    {
+        CSRAdjacencyIterator ret(*this);
+        ++id_;
+        return ret;
+    }
+
+    bool operator==(const CSRAdjacencyIterator& another) const noexcept
+    {
+        return id_ == another.id_;
+    }
+
+    bool operator!=(const CSRAdjacencyIterator& another) const noexcept
+    {
+        return id_ != another.id_;
+    }
+
+private:
+    const std::size_t* targets_;
+    std::size_t id_;
+};
+
+/**
+ * @brief 構築後に変更しない Compressed Sparse Row 形式のグラフ
+ * 頂点 v の隣接頂点は targets_[offsets_[v], offsets_[v + 1]) に昇順で並び、
+ * 重みは weights_ の同じ位置に入っている。
+ * 無向グラフの辺は両方向の 2 本として保持する。
+ *
+ * @tparam N node type
+ * @tparam E edge type
+ */
+template <typename N = std::size_t, typename E = std::size_t>
+class CSRGraph
+{
+public:
+    using NodeType = N;
+    using EdgeType = E;
+    using NeighborListType = Range<const std::size_t*>;
+    using AdjacencyListType = Range<CSRAdjacencyIterator>;
+    using EdgeListType = std::vector<std::tuple<std::size_t, std::size_t, EdgeType>>;
+
+    /**
+     * @brief SparseGraph / DenseGraph などから 1 pass で構築する
+     */
+    template <typename GraphType>
+    explicit CSRGraph(const GraphType& graph)
+        : undirected_(graph.undirected())
+    {
+        const std::size_t n = graph.size();
+
+        nodes_.reserve(n);
+        offsets_.assign(n + 1, 0);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            nodes_.push_back(graph.node(i));
+            offsets_[i + 1] = offsets_[i] + graph.neighbor(i).size();
+        }
+
+        targets_.resize(offsets_[n]);
+        weights_.resize(offsets_[n]);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            std::size_t pos = offsets_[i];
+            for (const auto& adj : graph.adjacent(i))
+            {
+                targets_[pos] = adj.first;
+                weights_[pos] = graph.edge_at(adj.second);
+                pos++;
+            }
+        }
+        sort_rows();
+    }
+
+    /**
+     * @brief 辺リストから構築する
+     *
+     * @param nodes 頂点の値
+     * @param edge_list (from, to, weight) の列
+     * @param undirected true なら各辺を両方向に張る
+     */
+    CSRGraph(std::vector<NodeType> nodes, const EdgeListType& edge_list, const bool undirected = true)
+        : nodes_(std::move(nodes))
+        , undirected_(undirected)
+    {
+        const std::size_t n = nodes_.size();
+
+        offsets_.assign(n + 1, 0);
+        for (const auto& e : edge_list)
+        {
+            offsets_[std::get<0>(e) + 1]++;
+            if (undirected_)
+            {
+                offsets_[std::get<1>(e) + 1]++;
+            }
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+        targets_.resize(offsets_[n]);
+        weights_.resize(offsets_[n]);
+        std::vector<std::size_t> pos(offsets_.begin(), offsets_.end() - 1);
+        for (const auto& e : edge_list)
+        {
+            const std::size_t from = std::get<0>(e);
+            const std::size_t to = std::get<1>(e);
+            targets_[pos[from]] = to;
+            weights_[pos[from]++] = std::get<2>(e);
+            if (undirected_)
+            {
+                targets_[pos[to]] = from;
+                weights_[pos[to]++] = std::get<2>(e);
+            }
+        }
+        sort_rows();
+    }
+
+    /**
+     * @brief CSR の配列から直接構築する。行の中の順序は問わない
+     *
+     * @param offsets 頂点 v の隣接頂点は targets[offsets[v], offsets[v + 1])
+     * @param undirected true なら、各辺が既に両方向の 2 本として入っていること
+     */
+    CSRGraph(std::vector<NodeType> nodes, std::vector<std::size_t> offsets, std::vector<std::size_t> targets, std::vector<EdgeType> weights, const bool undirected = true)
+        : nodes_(std::move(nodes))
+        , offsets_(std::move(offsets))
+        , targets_(std::move(targets))
+        , weights_(std::move(weights))
+        , undirected_(undirected)
+    {
+        assert(offsets_.size() == nodes_.size() + 1);
+        assert(offsets_.back() == targets_.size() && targets_.size() == weights_.size());
+        sort_rows();
+    }
+
+    const NodeType& node(const std::size_t index) const noexcept
+    {
+        return nodes_[index];
+    }
+
+    /**
+     * @brief from -> to の辺の重み。隣接リストの二分探索なので O(log deg)
+     */
+    const EdgeType& edge(const std::size_t from, const std::size_t to) const noexcept
+    {
+        const auto first = targets_.begin() + offsets_[from];
+        const auto last = targets_.begin() + offsets_[from + 1];
+        const auto it = std::lower_bound(first, last, to);
+        assert(it != last && *it == to);
+        return weights_[it - targets_.begin()];
+    }
+
+    const EdgeType& edge_at(const std::size_t id) const noexcept
+    {
+        return weights_[id];
+    }
+
+    NeighborListType neighbor(const std::size_t index) const noexcept
+    {
+        return NeighborListType(targets_.data() + offsets_[index], targets_.data() + offsets_[index + 1]);
+    }
+
+    /**
+     * @brief (行き先, 辺番号) の列。無向辺は向きごとに別の辺番号を持つ
+     */
+    AdjacencyListType adjacent(const std::size_t index) const noexcept
+    {
+        return AdjacencyListType(CSRAdjacencyIterator(targets_.data(), offsets_[index]), CSRAdjacencyIterator(targets_.data(), offsets_[index + 1]));
+    }
+
+    /**
+     * @brief 辺番号の総数 (無向辺は 2 本と数える)
+     */
+    std::size_t edge_size() const noexcept
+    {
+        return targets_.size();
+    }
+
+    std::size_t degree(const std::size_t index) const noexcept
+    {
+        return offsets_[index + 1] - offsets_[index];
+    }
+
+    std::size_t size() const noexcept
+    {
+        return nodes_.size();
+    }
+
+    bool undirected() const noexcept
+    {
+        return undirected_;
+    }
+
+private:
+    // 各行を行き先の昇順に並べ替える (edge() の二分探索用)
+    void sort_rows()
+    {
+        std::vector<std::size_t> order;
+        std::vector<std::size_t> tmp_targets;
+        std::vector<EdgeType> tmp_weights;
+
+        for (std::size_t v = 0; v < size(); v++)
+        {
+            const std::size_t first = offsets_[v];
+            const std::size_t last = offsets_[v + 1];
+            if (std::is_sorted(targets_.begin() + first, targets_.begin() + last))
+            {
+                continue;
+            }
+
+            order.resize(last - first);
+            std::iota(order.begin(), order.end(), first);
+            std::sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b) {
+                return targets_[a] < targets_[b];
+            });
+
+            tmp_targets.clear();
+            tmp_weights.clear();
+            for (auto i : order)
+            {
+                tmp_targets.push_back(targets_[i]);
+                tmp_weights.push_back(weights_[i]);
+            }
+            std::copy(tmp_targets.begin(), tmp_targets.end(), targets_.begin() + first);
+            std::copy(tmp_weights.begin(), tmp_weights.end(), weights_.begin() + first);
+        }
+    }
+
+    std::vector<NodeType> nodes_;
+
+    std::vector<std::size_t> offsets_;
+
+    std::vector<std::size_t> targets_;
+
+    std::vector<EdgeType> weights_;
+
+    bool undirected_;
+};
@@ -1,103 +1,180 @@
-#include "base.hpp"
+#pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <map>
-#include <queue>
-#include <unordered_set>
-#include <vector>
 #include <limits>
+#include <vector>
 
-template<typename NodeType>
+#include "base.hpp"
+#include "residual_graph.hpp"
+
+/**
+ * @brief Dinic 法による最大流
+ * 残余グラフは弧を連続に並べた ResidualGraph で持ち、current-arc と非再帰の DFS で
+ * blocking flow を求める。インスタンスを使い回せば doIt ごとの再確保は起こらない。
+ *
+ * @tparam CapacityType capacity type
+ */
+template <typename CapacityType = std::int64_t>
 class Dinic
 {
 public:
-    int doIt(const SparseGraph<NodeType, std::size_t> &orig_graph, const int s, const int t)
+    /**
+     * @brief graph の辺容量で s -> t の最大流を求める。無向辺は両向きに同じ容量を持つ
+     */
+    template <typename GraphType>
+    CapacityType doIt(const GraphType& graph, const std::size_t s, const std::size_t t)
+    {
+        graph_.assign(graph);
+        return flow(s, t);
+    }
+
+    /**
+     * @brief residual() に直接積んだ弧 (build 済み) に対して s -> t の最大流を求める
+     */
+    CapacityType flow(const std::size_t s, const std::size_t t)
     {
-        SparseGraph<NodeType, std::size_t> graph(orig_graph);
-        visited_.resize(graph.size(), false);
-        level_.resize(graph.size(), -1);
+        assert(s != t);
+        level_.resize(graph_.size());
+        current_.resize(graph_.size());
+        que_.resize(graph_.size());
 
-        // 逆辺を貼る
-        for (std::size_t i = 0; i < orig_graph.size(); i++)
+        CapacityType flow = 0;
+        while (bfs(s, t))
         {
-            for (auto nv : orig_graph.neighbor(i))
+            for (std::size_t v = 0; v < graph_.size(); v++)
             {
-                graph.connect(nv, i, 0);
+                current_[v] = graph_.first_arc(v);
             }
+            flow += blocking_flow(s, t);
         }
-        
-        std::size_t flow = 0;
-        while (true)
+        return flow;
+    }
+
+    /**
+     * @brief 直前の flow の最小カット。true が s 側 (残余グラフで s から到達できる頂点)
+     * flow (doIt) の後に呼ぶ。
+     */
+    std::vector<bool> min_cut() const
+    {
+        assert(level_.size() == graph_.size());
+        std::vector<bool> source_side(graph_.size());
+        for (std::size_t v = 0; v < graph_.size(); v++)
         {
-            bfs(graph, s);
-            if (level_[t] == -1)
-            {
-                return flow;
-            }
-            
-            while (true)
-            {
-                fill(visited_.begin(), visited_.end(), false);
-                const auto sub_flow = dfs(graph, s, t, std::numeric_limits<std::size_t>::max());
-                if (sub_flow == 0)
-                {
-                    break;
-                }
-                flow += sub_flow;
-            }
+            source_side[v] = level_[v] != Unreached();
         }
-        return flow;
+        return source_side;
+    }
+
+    ResidualGraph<CapacityType>& residual() noexcept
+    {
+        return graph_;
+    }
+
+    const ResidualGraph<CapacityType>& residual() const noexcept
+    {
+        return graph_;
     }
+
 private:
-    
-    std::vector<bool> visited_;
-    std::vector<std::int64_t> level_;
-    
-    void bfs(const SparseGraph<NodeType, std::size_t> &graph, const int s)
+    static constexpr std::size_t Unreached()
     {
-        fill(level_.begin(), level_.end(), -1);
-        std::queue<int> que;
-        que.push(s);
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    ResidualGraph<CapacityType> graph_;
+
+    std::vector<std::size_t> level_;
+    std::vector<std::size_t> current_;
+    std::vector<std::size_t> que_;
+    std::vector<std::size_t> path_;
+
+    // 残余グラフ上の s からの距離を求め、t に届くかを返す
+    bool bfs(const std::size_t s, const std::size_t t)
+    {
+        std::fill(level_.begin(), level_.end(), Unreached());
+        std::size_t head = 0;
+        std::size_t tail = 0;
+        que_[tail++] = s;
         level_[s] = 0;
-        
-        while (!que.empty())
+
+        while (head < tail)
         {
-            const auto v = que.front();
-            que.pop();
-            for (const auto nv : graph.neighbor(v))
+            const auto v = que_[head++];
+            for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
             {
-                if (graph.edge(v, nv) > 0 && level_[nv] == -1)
+                const auto nv = graph_.to(e);
+                if (graph_.capacity(e) > 0 && level_[nv] == Unreached())
                 {
                     level_[nv] = level_[v] + 1;
-                    que.push(nv);
+                    if (nv == t)
+                    {
+                        return true;
+                    }
+                    que_[tail++] = nv;
                 }
             }
         }
+        return false;
     }
-    
-    std::size_t dfs(SparseGraph<NodeType, std::size_t> &graph, const int s, const int t, std::size_t flow)
+
+    CapacityType blocking_flow(const std::size_t s, const std::size_t t)
     {
-        if (s == t)
-        {
-            return flow;
-        }
-        visited_[s] = true;
-        for (auto nv : graph.neighbor(s))
+        CapacityType flow = 0;
+        path_.clear();
+        std::size_t v = s;
+
+        while (true)
         {
-            const auto &e = graph.edge(s, nv);
-            if (e > 0 && !visited_[nv] && level_[s] < level_[nv])
+            if (v == t)
             {
-                const auto ret = dfs(graph, nv, t, std::min(e, flow));
-                if (ret > 0)
+                CapacityType f = std::numeric_limits<CapacityType>::max();
+                for (auto e : path_)
                 {
-                    // 容量の調整
-                    graph.edge(s, nv) -= ret;
-                    graph.edge(nv, s) += ret;
-                    return ret;
+                    f = std::min(f, graph_.capacity(e));
                 }
+
+                // 容量の調整。最初に飽和した弧の始点まで戻る
+                std::size_t saturated = path_.size();
+                for (std::size_t i = 0; i < path_.size(); i++)
+                {
+                    graph_.push(path_[i], f);
+                    if (saturated == path_.size() && graph_.capacity(path_[i]) == 0)
+                    {
+                        saturated = i;
+                    }
+                }
+                flow += f;
+                path_.resize(saturated);
+                v = path_.empty() ? s : graph_.to(path_.back());
+                continue;
+            }
+
+            auto& e = current_[v];
+            while (e < graph_.last_arc(v) && (graph_.capacity(e) == 0 || level_[graph_.to(e)] != level_[v] + 1))
+            {
+                e++;
+            }
+
+            if (e < graph_.last_arc(v))
+            {
+                path_.push_back(e);
+                v = graph_.to(e);
+            }
+            else
+            {
+                // 行き止まり。以降この頂点には入らない
+                level_[v] = Unreached();
+                if (path_.empty())
+                {
+                    break;
+                }
+                v = graph_.from(path_.back());
+                path_.pop_back();
+                current_[v]++;
             }
         }
-        return 0;
+        return flow;
     }
-};
\ No newline at end of file
+};
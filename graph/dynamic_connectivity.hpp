@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "union_find.hpp"
+
+/**
+ * @brief 辺の追加・削除と連結性の問い合わせをまとめて先読みで処理する (offline dynamic connectivity)
+ * 各辺が存在する問い合わせの区間を時間軸のセグメント木の O(log Q) 個のノードに載せ、
+ * 木を DFS しながら RollbackUnionFind に辺を足し、戻るときに巻き戻す。O((Q + E) log Q log V)。
+ * 同じ辺を複数回追加した場合は多重辺として扱う。
+ */
+class OfflineDynamicConnectivity
+{
+public:
+    explicit OfflineDynamicConnectivity(const std::size_t n)
+        : size_(n)
+    {
+    }
+
+    void add_edge(std::size_t u, std::size_t v)
+    {
+        if (u > v)
+        {
+            std::swap(u, v);
+        }
+        open_[std::make_pair(u, v)].push_back(queries_.size());
+    }
+
+    /**
+     * @brief 追加済みの辺 u - v を 1 本取り除く
+     */
+    void erase_edge(std::size_t u, std::size_t v)
+    {
+        if (u > v)
+        {
+            std::swap(u, v);
+        }
+        auto it = open_.find(std::make_pair(u, v));
+        assert(it != open_.end() && !it->second.empty());
+        intervals_.emplace_back(u, v, it->second.back(), queries_.size());
+        it->second.pop_back();
+        if (it->second.empty())
+        {
+            open_.erase(it);
+        }
+    }
+
+    /**
+     * @brief この時点で u と v が連結かを問い合わせる (答えは 1 / 0)
+     *
+     * @return 問い合わせ番号
+     */
+    std::size_t query_same(const std::size_t u, const std::size_t v)
+    {
+        queries_.emplace_back(u, v);
+        return queries_.size() - 1;
+    }
+
+    /**
+     * @brief この時点の連結成分の数を問い合わせる
+     *
+     * @return 問い合わせ番号
+     */
+    std::size_t query_count()
+    {
+        queries_.emplace_back(None(), None());
+        return queries_.size() - 1;
+    }
+
+    /**
+     * @brief 全ての問い合わせに答える。i 番目が問い合わせ番号 i の答え
+     */
+    std::vector<std::size_t> solve()
+    {
+        const std::size_t q = queries_.size();
+        std::vector<std::size_t> answer(q);
+        if (q == 0)
+        {
+            return answer;
+        }
+
+        leaf_size_ = 1;
+        while (leaf_size_ < q)
+        {
+            leaf_size_ *= 2;
+        }
+        segments_.assign(2 * leaf_size_, {});
+
+        for (const auto& e : intervals_)
+        {
+            insert(std::get<0>(e), std::get<1>(e), std::get<2>(e), std::get<3>(e));
+        }
+        for (const auto& e : open_)
+        {
+            for (const auto begin : e.second)
+            {
+                insert(e.first.first, e.first.second, begin, q);
+            }
+        }
+
+        RollbackUnionFind<> uf(size_);
+        dfs(1, uf, answer);
+        return answer;
+    }
+
+private:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    std::size_t size_;
+
+    // 問い合わせ (u, v)。成分数の問い合わせは (None, None)
+    std::vector<std::pair<std::size_t, std::size_t>> queries_;
+
+    // 削除済みの辺 (u, v, 存在した問い合わせの区間 [begin, end))
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t, std::size_t>> intervals_;
+
+    // まだ削除されていない辺と、その追加時刻
+    std::map<std::pair<std::size_t, std::size_t>, std::vector<std::size_t>> open_;
+
+    // 1-indexed のセグメント木。ノードに載った辺はその区間全体で存在する
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> segments_;
+    std::size_t leaf_size_ = 0;
+
+    void insert(const std::size_t u, const std::size_t v, std::size_t begin, std::size_t end)
+    {
+        for (begin += leaf_size_, end += leaf_size_; begin < end; begin /= 2, end /= 2)
+        {
+            if (begin & 1)
+            {
+                segments_[begin++].emplace_back(u, v);
+            }
+            if (end & 1)
+            {
+                segments_[--end].emplace_back(u, v);
+            }
+        }
+    }
+
+    // 再帰の深さは log Q
+    void dfs(const std::size_t k, RollbackUnionFind<>& uf, std::vector<std::size_t>& answer)
+    {
+        if (k >= leaf_size_ && k - leaf_size_ >= queries_.size())
+        {
+            return;
+        }
+
+        const std::size_t state = uf.snapshot();
+        for (const auto& e : segments_[k])
+        {
+            uf.Unite(e.first, e.second);
+        }
+        if (k >= leaf_size_)
+        {
+            const auto& query = queries_[k - leaf_size_];
+            answer[k - leaf_size_] = query.first == None() ? uf.Count() : (uf.Same(query.first, query.second) ? 1 : 0);
+        }
+        else
+        {
+            dfs(2 * k, uf, answer);
+            dfs(2 * k + 1, uf, answer);
+        }
+        uf.rollback(state);
+    }
+};
@@ -51,16 +51,17 @@ private:
             return flow;
         }
         visited_[s] = true;
-        for (auto nv : graph.neighbor(s))
+        for (const auto& adj : graph.adjacent(s))
         {
-            const auto &e = graph.edge(s, nv);
+            const auto nv = adj.first;
+            auto& e = graph.edge_at(adj.second);
             if (e > 0 && !visited_[nv])
             {
                 const auto ret = dfs(graph, nv, t, std::min(e, flow));
                 if (ret > 0)
                 {
                     // 容量の調整
-                    graph.edge(s, nv) -= ret;
+                    e -= ret;
                     graph.edge(nv, s) += ret;
                     return ret;
                 }
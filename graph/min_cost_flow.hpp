@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base.hpp"
+#include "residual_graph.hpp"
+
+/**
+ * @brief 最短路反復 (primal-dual) による最小費用流
+ * ポテンシャルで辺コストを非負に保ち、各増加路を二分ヒープの Dijkstra (O(E log V)) で求める。
+ * 負コストの辺がある場合だけ、最初に Bellman-Ford でポテンシャルを初期化する (負閉路は不可)。
+ *
+ * @tparam CapacityType capacity type
+ * @tparam CostType cost type
+ */
+template <typename CapacityType = std::int64_t, typename CostType = std::int64_t>
+class MinCostFlow
+{
+public:
+    explicit MinCostFlow(const std::size_t n = 0)
+    {
+        clear(n);
+    }
+
+    void clear(const std::size_t n)
+    {
+        graph_.clear(n);
+        costs_.clear();
+        built_ = false;
+    }
+
+    /**
+     * @brief from -> to に容量 capacity、単位コスト cost の辺を張る
+     *
+     * @return 辺番号 (edge_flow に渡す)
+     */
+    std::size_t add_edge(const std::size_t from, const std::size_t to, const CapacityType capacity, const CostType cost)
+    {
+        assert(!built_);
+        costs_.push_back(cost);
+        return graph_.add_arc(from, to, capacity);
+    }
+
+    /**
+     * @brief 辺の重みが (容量, コスト) の pair であるグラフから組み立てる。無向辺は両向きの 2 辺にする
+     */
+    template <typename GraphType>
+    void assign(const GraphType& graph)
+    {
+        clear(graph.size());
+        for (std::size_t v = 0; v < graph.size(); v++)
+        {
+            for (const auto& adj : graph.adjacent(v))
+            {
+                const auto& e = graph.edge_at(adj.second);
+                add_edge(v, adj.first, e.first, e.second);
+            }
+        }
+    }
+
+    /**
+     * @brief s -> t に最大 limit だけ流す。前回までに流した分の続きから流す
+     *
+     * @return (流量, コスト)
+     */
+    std::pair<CapacityType, CostType> flow(const std::size_t s, const std::size_t t, const CapacityType limit = std::numeric_limits<CapacityType>::max())
+    {
+        return slope(s, t, limit).back();
+    }
+
+    /**
+     * @brief 流量に対するコストの折れ線 (凸関数) の頂点列。(0, 0) から始まり、傾きが同じ区間はまとめる
+     */
+    std::vector<std::pair<CapacityType, CostType>> slope(const std::size_t s, const std::size_t t, const CapacityType limit = std::numeric_limits<CapacityType>::max())
+    {
+        assert(s != t);
+        prepare();
+
+        std::vector<std::pair<CapacityType, CostType>> result;
+        result.emplace_back(0, 0);
+
+        CapacityType flow = 0;
+        CostType cost = 0;
+        CostType prev_unit_cost = 0;
+        while (flow < limit && dijkstra(s, t))
+        {
+            CapacityType f = limit - flow;
+            for (std::size_t v = t; v != s; v = graph_.from(prev_arc_[v]))
+            {
+                f = std::min(f, graph_.capacity(prev_arc_[v]));
+            }
+            for (std::size_t v = t; v != s; v = graph_.from(prev_arc_[v]))
+            {
+                graph_.push(prev_arc_[v], f);
+            }
+
+            const CostType unit_cost = potential_[t] - potential_[s];
+            flow += f;
+            cost += unit_cost * f;
+            // 始点 (0, 0) は残す
+            if (result.size() > 1 && prev_unit_cost == unit_cost)
+            {
+                result.pop_back();
+            }
+            result.emplace_back(flow, cost);
+            prev_unit_cost = unit_cost;
+        }
+        return result;
+    }
+
+    /**
+     * @brief add_edge で張った辺 id に流れている量
+     */
+    CapacityType edge_flow(const std::size_t id) const
+    {
+        return graph_.flow(graph_.arc_id(id));
+    }
+
+private:
+    static constexpr CostType Infinity()
+    {
+        return std::numeric_limits<CostType>::max();
+    }
+
+    ResidualGraph<CapacityType> graph_;
+
+    // add_edge 順のコスト
+    std::vector<CostType> costs_;
+
+    // 弧番号順のコスト
+    std::vector<CostType> arc_cost_;
+
+    std::vector<CostType> potential_;
+    std::vector<CostType> distance_;
+    std::vector<std::size_t> prev_arc_;
+    std::vector<bool> visited_;
+
+    using HeapElement = std::pair<CostType, std::size_t>;
+    std::vector<HeapElement> heap_;
+
+    bool built_ = false;
+
+    void prepare()
+    {
+        if (built_)
+        {
+            return;
+        }
+        built_ = true;
+        graph_.build();
+
+        const std::size_t n = graph_.size();
+        arc_cost_.resize(graph_.arc_size());
+        bool negative = false;
+        for (std::size_t i = 0; i < costs_.size(); i++)
+        {
+            const std::size_t e = graph_.arc_id(i);
+            arc_cost_[e] = costs_[i];
+            arc_cost_[graph_.reverse(e)] = -costs_[i];
+            negative |= costs_[i] < 0 && graph_.capacity(e) > 0;
+        }
+
+        potential_.assign(n, 0);
+        distance_.resize(n);
+        prev_arc_.resize(n);
+        visited_.resize(n);
+
+        if (negative)
+        {
+            bellman_ford();
+        }
+    }
+
+    // 全頂点を始点とした Bellman-Ford でポテンシャルを初期化する
+    void bellman_ford()
+    {
+        const std::size_t n = graph_.size();
+        for (std::size_t iter = 0; iter < n; iter++)
+        {
+            bool updated = false;
+            for (std::size_t v = 0; v < n; v++)
+            {
+                for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
+                {
+                    const auto nv = graph_.to(e);
+                    if (graph_.capacity(e) > 0 && potential_[v] + arc_cost_[e] < potential_[nv])
+                    {
+                        potential_[nv] = potential_[v] + arc_cost_[e];
+                        updated = true;
+                    }
+                }
+            }
+            if (!updated)
+            {
+                return;
+            }
+        }
+        assert(false && "negative cycle");
+    }
+
+    // 被約コストでの s からの最短路。t に届いたら打ち切ってポテンシャルを更新する
+    bool dijkstra(const std::size_t s, const std::size_t t)
+    {
+        std::fill(distance_.begin(), distance_.end(), Infinity());
+        std::fill(visited_.begin(), visited_.end(), false);
+        heap_.clear();
+
+        distance_[s] = 0;
+        heap_.emplace_back(0, s);
+        while (!heap_.empty())
+        {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapElement>());
+            const auto v = heap_.back().second;
+            heap_.pop_back();
+            if (visited_[v])
+            {
+                continue;
+            }
+            visited_[v] = true;
+            if (v == t)
+            {
+                break;
+            }
+
+            for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
+            {
+                const auto nv = graph_.to(e);
+                if (visited_[nv] || graph_.capacity(e) == 0)
+                {
+                    continue;
+                }
+                const CostType d = distance_[v] + arc_cost_[e] + potential_[v] - potential_[nv];
+                if (d < distance_[nv])
+                {
+                    distance_[nv] = d;
+                    prev_arc_[nv] = e;
+                    heap_.emplace_back(d, nv);
+                    std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapElement>());
+                }
+            }
+        }
+
+        if (!visited_[t])
+        {
+            return false;
+        }
+        for (std::size_t v = 0; v < graph_.size(); v++)
+        {
+            if (visited_[v])
+            {
+                potential_[v] += distance_[v] - distance_[t];
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../thread/parallel_sort.hpp"
+#include "../thread/thread_pool.hpp"
+#include "base.hpp"
+#include "union_find.hpp"
+
+/**
+ * @brief 最小全域森
+ * edges は (from, to, weight) の列で、CSRGraph(nodes, edges) にそのまま渡せる。
+ */
+template <typename EdgeType>
+struct MinimumSpanningForest
+{
+    EdgeType cost = EdgeType();
+    std::vector<std::tuple<std::size_t, std::size_t, EdgeType>> edges;
+};
+
+// 各辺を 1 回ずつ (無向グラフでは from < to の向きだけ) 取り出す。自己ループは捨てる
+template <typename GraphType>
+std::vector<std::tuple<std::size_t, std::size_t, typename GraphType::EdgeType>> undirected_edge_list(const GraphType& graph)
+{
+    std::vector<std::tuple<std::size_t, std::size_t, typename GraphType::EdgeType>> edges;
+    for (std::size_t v = 0; v < graph.size(); v++)
+    {
+        for (const auto& adj : graph.adjacent(v))
+        {
+            if (adj.first == v || (graph.undirected() && adj.first < v))
+            {
+                continue;
+            }
+            edges.emplace_back(v, adj.first, graph.edge_at(adj.second));
+        }
+    }
+    return edges;
+}
+
+/**
+ * @brief 重みの昇順に並んだ辺から Kruskal 法で森を作る
+ */
+template <typename EdgeType>
+MinimumSpanningForest<EdgeType> kruskal_sorted(const std::size_t n, const std::vector<std::tuple<std::size_t, std::size_t, EdgeType>>& edges)
+{
+    MinimumSpanningForest<EdgeType> forest;
+    CompactUnionFind<std::int64_t> uf(n);
+    for (const auto& e : edges)
+    {
+        if (forest.edges.size() + 1 >= n)
+        {
+            break;
+        }
+        if (uf.Unite(std::get<0>(e), std::get<1>(e)))
+        {
+            forest.cost += std::get<2>(e);
+            forest.edges.push_back(e);
+        }
+    }
+    return forest;
+}
+
+/**
+ * @brief Kruskal 法による最小全域森 (有向グラフの辺は向きを無視する)
+ */
+template <typename GraphType>
+MinimumSpanningForest<typename GraphType::EdgeType> kruskal(const GraphType& graph)
+{
+    using EdgeType = typename GraphType::EdgeType;
+
+    auto edges = undirected_edge_list(graph);
+    std::sort(edges.begin(), edges.end(), [](const std::tuple<std::size_t, std::size_t, EdgeType>& a, const std::tuple<std::size_t, std::size_t, EdgeType>& b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+    return kruskal_sorted(graph.size(), edges);
+}
+
+/**
+ * @brief 辺の並べ替えをスレッドプールで行う Kruskal 法
+ * 辺が多いとき (Delaunay グラフの Euclid 最小全域木など) は並べ替えが支配的なので、その部分だけ並列にする。
+ */
+template <typename GraphType>
+MinimumSpanningForest<typename GraphType::EdgeType> kruskal(const GraphType& graph, ThreadPool& pool)
+{
+    using EdgeType = typename GraphType::EdgeType;
+
+    auto edges = undirected_edge_list(graph);
+    parallel_sort(edges.begin(), edges.end(), pool, [](const std::tuple<std::size_t, std::size_t, EdgeType>& a, const std::tuple<std::size_t, std::size_t, EdgeType>& b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+    return kruskal_sorted(graph.size(), edges);
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base.hpp"
+
+/**
+ * @brief 頂点の座標 (Point など、差と Norm2 を持つ型) のユークリッド距離
+ */
+struct EuclideanHeuristic
+{
+    template <typename NodeType>
+    double operator()(const NodeType& from, const NodeType& to) const noexcept
+    {
+        return std::sqrt(static_cast<double>((from - to).Norm2()));
+    }
+};
+
+/**
+ * @brief 頂点の値を座標の配列の添字として引くユークリッド距離
+ * GetDelaunayGraph や GetGabrielGraph のように、頂点の値が点の番号のグラフで使う。
+ * 座標の配列は探索の間生きていなければならない。
+ */
+template <typename PointType>
+class PositionHeuristic
+{
+public:
+    explicit PositionHeuristic(const std::vector<PointType>& position_list) noexcept
+        : position_list_(position_list)
+    {
+    }
+
+    template <typename NodeType>
+    double operator()(const NodeType& from, const NodeType& to) const noexcept
+    {
+        const auto& p = position_list_[static_cast<std::size_t>(from)];
+        const auto& q = position_list_[static_cast<std::size_t>(to)];
+        return std::sqrt(static_cast<double>((p - q).Norm2()));
+    }
+
+private:
+    const std::vector<PointType>& position_list_;
+};
+
+/**
+ * @brief 2 点間の最短路を繰り返し求めるための探索状態 (A* / 双方向 Dijkstra)
+ * 触った頂点だけを記録して次の探索の前に戻すので、1 回の探索のコストはグラフの大きさによらない。
+ * 重みは非負とする。
+ *
+ * @tparam CostType cost type (graph の EdgeType)
+ */
+template <typename CostType>
+class PointToPointSearch
+{
+public:
+    static constexpr CostType Infinity()
+    {
+        return std::numeric_limits<CostType>::max();
+    }
+
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    /**
+     * @brief A* で start から goal までの最短距離を求める。到達できなければ Infinity()
+     * heuristic(node(v), node(goal)) は実際の距離以下 (admissible) でなければならない。
+     * 頂点の値が点の番号のグラフ (GetDelaunayGraph など) では PositionHeuristic を渡す。
+     */
+    template <typename GraphType, typename Heuristic = EuclideanHeuristic>
+    CostType astar(const GraphType& graph, const std::size_t start, const std::size_t goal, Heuristic heuristic = Heuristic())
+    {
+        prepare(graph.size());
+        bidirectional_ = false;
+        auto& distance = distance_[0];
+        auto& parent = parent_[0];
+        auto& heap = heap_[0];
+        const auto& goal_node = graph.node(goal);
+
+        touch(start);
+        distance[start] = 0;
+        estimate_[start] = static_cast<CostType>(heuristic(graph.node(start), goal_node));
+        push(heap, estimate_[start], start);
+        while (!heap.empty())
+        {
+            CostType key;
+            std::size_t v;
+            std::tie(key, v) = pop(heap);
+            if (distance[v] + estimate_[v] < key)
+            {
+                continue;
+            }
+            settled_++;
+            if (v == goal)
+            {
+                meet_ = goal;
+                return distance[goal];
+            }
+
+            for (const auto& adj : graph.adjacent(v))
+            {
+                const auto nv = adj.first;
+                const CostType nd = distance[v] + graph.edge_at(adj.second);
+                if (nd < distance[nv])
+                {
+                    if (touch(nv))
+                    {
+                        estimate_[nv] = static_cast<CostType>(heuristic(graph.node(nv), goal_node));
+                    }
+                    distance[nv] = nd;
+                    parent[nv] = v;
+                    push(heap, nd + estimate_[nv], nv);
+                }
+            }
+        }
+        return Infinity();
+    }
+
+    /**
+     * @brief 双方向 Dijkstra で start から goal までの最短距離を求める。到達できなければ Infinity()
+     * reverse_graph は graph の辺を逆向きにしたグラフ (無向グラフなら graph 自身)。
+     */
+    template <typename GraphType>
+    CostType bidirectional_dijkstra(const GraphType& graph, const GraphType& reverse_graph, const std::size_t start, const std::size_t goal)
+    {
+        prepare(graph.size());
+        bidirectional_ = true;
+
+        touch(start);
+        distance_[0][start] = 0;
+        push(heap_[0], 0, start);
+        touch(goal);
+        distance_[1][goal] = 0;
+        push(heap_[1], 0, goal);
+
+        CostType best = start == goal ? 0 : Infinity();
+        meet_ = start == goal ? start : None();
+        while (!heap_[0].empty() && !heap_[1].empty())
+        {
+            // 両側の最小値の和が暫定解以上になったら、これ以上短い路はない
+            if (best != Infinity() && heap_[0].front().first + heap_[1].front().first >= best)
+            {
+                break;
+            }
+
+            // 小さい方のキューを進める
+            const int side = heap_[0].size() <= heap_[1].size() ? 0 : 1;
+            const GraphType& g = side == 0 ? graph : reverse_graph;
+            auto& distance = distance_[side];
+            const auto& other = distance_[1 - side];
+
+            CostType d;
+            std::size_t v;
+            std::tie(d, v) = pop(heap_[side]);
+            if (distance[v] < d)
+            {
+                continue;
+            }
+            settled_++;
+
+            for (const auto& adj : g.adjacent(v))
+            {
+                const auto nv = adj.first;
+                const CostType nd = d + g.edge_at(adj.second);
+                if (nd < distance[nv])
+                {
+                    touch(nv);
+                    distance[nv] = nd;
+                    parent_[side][nv] = v;
+                    push(heap_[side], nd, nv);
+                }
+                if (distance[nv] != Infinity() && other[nv] != Infinity() && distance[nv] + other[nv] < best)
+                {
+                    best = distance[nv] + other[nv];
+                    meet_ = nv;
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief 無向グラフ用の双方向 Dijkstra
+     */
+    template <typename GraphType>
+    CostType bidirectional_dijkstra(const GraphType& graph, const std::size_t start, const std::size_t goal)
+    {
+        assert(graph.undirected());
+        return bidirectional_dijkstra(graph, graph, start, goal);
+    }
+
+    /**
+     * @brief 直前の探索で見つけた最短路の頂点列。見つからなかった場合は空
+     */
+    std::vector<std::size_t> path() const
+    {
+        std::vector<std::size_t> ret;
+        if (meet_ == None())
+        {
+            return ret;
+        }
+        for (std::size_t v = meet_; v != None(); v = parent_[0][v])
+        {
+            ret.push_back(v);
+        }
+        std::reverse(ret.begin(), ret.end());
+        if (!bidirectional_)
+        {
+            return ret;
+        }
+        for (std::size_t v = parent_[1][meet_]; v != None(); v = parent_[1][v])
+        {
+            ret.push_back(v);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 直前の探索で確定した頂点の数
+     */
+    std::size_t settled() const noexcept
+    {
+        return settled_;
+    }
+
+private:
+    using HeapElement = std::pair<CostType, std::size_t>;
+
+    std::vector<CostType> distance_[2];
+    std::vector<std::size_t> parent_[2];
+    std::vector<CostType> estimate_;
+    std::vector<HeapElement> heap_[2];
+
+    // 直前の探索で値を書き換えた頂点
+    std::vector<std::size_t> touched_;
+
+    std::size_t meet_ = None();
+    std::size_t settled_ = 0;
+    bool bidirectional_ = false;
+
+    // 前回の探索で触った頂点だけを初期状態に戻す
+    void prepare(const std::size_t n)
+    {
+        if (distance_[0].size() != n)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                distance_[side].assign(n, Infinity());
+                parent_[side].assign(n, None());
+            }
+            estimate_.assign(n, 0);
+            touched_.clear();
+        }
+        for (auto v : touched_)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                distance_[side][v] = Infinity();
+                parent_[side][v] = None();
+            }
+        }
+        touched_.clear();
+        heap_[0].clear();
+        heap_[1].clear();
+        meet_ = None();
+        settled_ = 0;
+    }
+
+    // 初めて触る頂点なら記録して true を返す
+    bool touch(const std::size_t v)
+    {
+        if (distance_[0][v] == Infinity() && distance_[1][v] == Infinity())
+        {
+            touched_.push_back(v);
+            return true;
+        }
+        return false;
+    }
+
+    static void push(std::vector<HeapElement>& heap, const CostType key, const std::size_t v)
+    {
+        heap.emplace_back(key, v);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapElement>());
+    }
+
+    static HeapElement pop(std::vector<HeapElement>& heap)
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapElement>());
+        const auto ret = heap.back();
+        heap.pop_back();
+        return ret;
+    }
+};
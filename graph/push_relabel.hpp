@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base.hpp"
+#include "residual_graph.hpp"
+
+enum class PushRelabelRule
+{
+    FIFO,
+    HighestLabel,
+};
+
+/**
+ * @brief push-relabel 法による最大流 (global relabeling + gap heuristic)
+ * 最大流の値と最小カットだけを求める (preflow のまま止めるので、各弧の流量は流れになっていない)。
+ * 入出力は Dinic と同じで、doIt(graph, s, t) で最大流、min_cut() で最小カットを返す。
+ *
+ * @tparam CapacityType capacity type
+ */
+template <typename CapacityType = std::int64_t>
+class PushRelabel
+{
+public:
+    explicit PushRelabel(const PushRelabelRule rule = PushRelabelRule::HighestLabel) noexcept
+        : rule_(rule)
+    {
+    }
+
+    template <typename GraphType>
+    CapacityType doIt(const GraphType& graph, const std::size_t s, const std::size_t t)
+    {
+        graph_.assign(graph);
+        return flow(s, t);
+    }
+
+    /**
+     * @brief residual() に直接積んだ弧 (build 済み) に対して s -> t の最大流を求める
+     */
+    CapacityType flow(const std::size_t s, const std::size_t t)
+    {
+        assert(s != t);
+        const std::size_t n = graph_.size();
+        s_ = s;
+        t_ = t;
+
+        height_.resize(n);
+        excess_.assign(n, 0);
+        current_.resize(n);
+        que_.resize(n);
+        all_head_.resize(n);
+        all_next_.resize(n);
+        all_prev_.resize(n);
+        active_head_.resize(n);
+        active_next_.resize(n);
+        fifo_.resize(n);
+
+        for (std::size_t e = graph_.first_arc(s); e < graph_.last_arc(s); e++)
+        {
+            const CapacityType f = graph_.capacity(e);
+            if (f > 0)
+            {
+                graph_.push(e, f);
+                excess_[graph_.to(e)] += f;
+            }
+        }
+
+        global_relabel();
+        while (true)
+        {
+            const std::size_t v = pop_active();
+            if (v == None())
+            {
+                break;
+            }
+            discharge(v);
+            if (work_ > 4 * n + graph_.arc_size())
+            {
+                global_relabel();
+            }
+        }
+        return excess_[t];
+    }
+
+    /**
+     * @brief 直前の flow の最小カット。true が s 側 (残余グラフで t に到達できない頂点)
+     * flow (doIt) の後に呼ぶ。
+     */
+    std::vector<bool> min_cut() const
+    {
+        assert(height_.size() == graph_.size());
+        std::vector<bool> sink_side(graph_.size(), false);
+        std::vector<std::size_t> que;
+        que.push_back(t_);
+        sink_side[t_] = true;
+        for (std::size_t i = 0; i < que.size(); i++)
+        {
+            const auto v = que[i];
+            for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
+            {
+                const auto nv = graph_.to(e);
+                if (!sink_side[nv] && graph_.capacity(graph_.reverse(e)) > 0)
+                {
+                    sink_side[nv] = true;
+                    que.push_back(nv);
+                }
+            }
+        }
+        sink_side.flip();
+        return sink_side;
+    }
+
+    ResidualGraph<CapacityType>& residual() noexcept
+    {
+        return graph_;
+    }
+
+    const ResidualGraph<CapacityType>& residual() const noexcept
+    {
+        return graph_;
+    }
+
+private:
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    PushRelabelRule rule_;
+
+    ResidualGraph<CapacityType> graph_;
+
+    std::size_t s_ = 0;
+    std::size_t t_ = 0;
+
+    std::vector<std::size_t> height_;
+    std::vector<CapacityType> excess_;
+    std::vector<std::size_t> current_;
+    std::vector<std::size_t> que_;
+
+    // 高さごとの全頂点の双方向リスト (gap の検出用)
+    std::vector<std::size_t> all_head_;
+    std::vector<std::size_t> all_next_;
+    std::vector<std::size_t> all_prev_;
+    std::size_t max_height_ = 0;
+
+    // 高さごとの活性頂点のスタック (HighestLabel 用)
+    std::vector<std::size_t> active_head_;
+    std::vector<std::size_t> active_next_;
+    std::size_t max_active_ = 0;
+
+    // 活性頂点の循環キュー (FIFO 用)
+    std::vector<std::size_t> fifo_;
+    std::size_t fifo_head_ = 0;
+    std::size_t fifo_size_ = 0;
+
+    std::size_t work_ = 0;
+
+    void insert_height(const std::size_t v)
+    {
+        const std::size_t h = height_[v];
+        all_prev_[v] = None();
+        all_next_[v] = all_head_[h];
+        if (all_head_[h] != None())
+        {
+            all_prev_[all_head_[h]] = v;
+        }
+        all_head_[h] = v;
+        max_height_ = std::max(max_height_, h);
+    }
+
+    void erase_height(const std::size_t v)
+    {
+        if (all_prev_[v] != None())
+        {
+            all_next_[all_prev_[v]] = all_next_[v];
+        }
+        else
+        {
+            all_head_[height_[v]] = all_next_[v];
+        }
+        if (all_next_[v] != None())
+        {
+            all_prev_[all_next_[v]] = all_prev_[v];
+        }
+    }
+
+    void push_active(const std::size_t v)
+    {
+        if (rule_ == PushRelabelRule::HighestLabel)
+        {
+            const std::size_t h = height_[v];
+            active_next_[v] = active_head_[h];
+            active_head_[h] = v;
+            max_active_ = std::max(max_active_, h);
+        }
+        else
+        {
+            fifo_[(fifo_head_ + fifo_size_) % fifo_.size()] = v;
+            fifo_size_++;
+        }
+    }
+
+    std::size_t pop_active()
+    {
+        const std::size_t n = graph_.size();
+        if (rule_ == PushRelabelRule::HighestLabel)
+        {
+            while (true)
+            {
+                if (active_head_[max_active_] != None())
+                {
+                    const std::size_t v = active_head_[max_active_];
+                    active_head_[max_active_] = active_next_[v];
+                    return v;
+                }
+                if (max_active_ == 0)
+                {
+                    return None();
+                }
+                max_active_--;
+            }
+        }
+        while (fifo_size_ > 0)
+        {
+            const std::size_t v = fifo_[fifo_head_];
+            fifo_head_ = (fifo_head_ + 1) % fifo_.size();
+            fifo_size_--;
+            // gap で持ち上げられた頂点は捨てる
+            if (height_[v] < n)
+            {
+                return v;
+            }
+        }
+        return None();
+    }
+
+    // 残余グラフ上の t までの距離で高さを付け直す
+    void global_relabel()
+    {
+        const std::size_t n = graph_.size();
+        work_ = 0;
+
+        std::fill(height_.begin(), height_.end(), n);
+        std::fill(all_head_.begin(), all_head_.end(), None());
+        std::fill(active_head_.begin(), active_head_.end(), None());
+        max_height_ = 0;
+        max_active_ = 0;
+        fifo_head_ = 0;
+        fifo_size_ = 0;
+
+        std::size_t head = 0;
+        std::size_t tail = 0;
+        que_[tail++] = t_;
+        height_[t_] = 0;
+        while (head < tail)
+        {
+            const auto v = que_[head++];
+            for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
+            {
+                const auto nv = graph_.to(e);
+                if (height_[nv] == n && nv != s_ && graph_.capacity(graph_.reverse(e)) > 0)
+                {
+                    height_[nv] = height_[v] + 1;
+                    que_[tail++] = nv;
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < tail; i++)
+        {
+            const auto v = que_[i];
+            current_[v] = graph_.first_arc(v);
+            if (v == t_)
+            {
+                continue;
+            }
+            insert_height(v);
+            if (excess_[v] > 0)
+            {
+                push_active(v);
+            }
+        }
+    }
+
+    void discharge(const std::size_t v)
+    {
+        const std::size_t n = graph_.size();
+        while (excess_[v] > 0)
+        {
+            if (current_[v] == graph_.last_arc(v))
+            {
+                relabel(v);
+                if (height_[v] >= n)
+                {
+                    return;
+                }
+                continue;
+            }
+
+            const std::size_t e = current_[v];
+            const std::size_t nv = graph_.to(e);
+            if (graph_.capacity(e) > 0 && height_[v] == height_[nv] + 1)
+            {
+                const CapacityType f = std::min(excess_[v], graph_.capacity(e));
+                graph_.push(e, f);
+                excess_[v] -= f;
+                if (excess_[nv] == 0 && nv != t_)
+                {
+                    push_active(nv);
+                }
+                excess_[nv] += f;
+            }
+            else
+            {
+                current_[v]++;
+            }
+        }
+    }
+
+    void relabel(const std::size_t v)
+    {
+        const std::size_t n = graph_.size();
+        const std::size_t old_height = height_[v];
+
+        std::size_t new_height = n;
+        for (std::size_t e = graph_.first_arc(v); e < graph_.last_arc(v); e++)
+        {
+            if (graph_.capacity(e) > 0)
+            {
+                new_height = std::min(new_height, height_[graph_.to(e)] + 1);
+            }
+        }
+        work_ += graph_.last_arc(v) - graph_.first_arc(v) + 12;
+        current_[v] = graph_.first_arc(v);
+
+        erase_height(v);
+        if (all_head_[old_height] == None())
+        {
+            // gap: old_height より上の頂点はもう t に届かない
+            for (std::size_t h = old_height + 1; h <= max_height_; h++)
+            {
+                for (std::size_t u = all_head_[h]; u != None(); u = all_next_[u])
+                {
+                    height_[u] = n;
+                }
+                all_head_[h] = None();
+            }
+            max_height_ = old_height == 0 ? 0 : old_height - 1;
+            height_[v] = n;
+            return;
+        }
+
+        height_[v] = new_height;
+        if (new_height < n)
+        {
+            insert_height(v);
+        }
+    }
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "base.hpp"
+
+/**
+ * @brief フローアルゴリズム用の残余グラフ
+ * 弧は始点ごとに連続した番号を持ち、逆弧の番号を reverse(e) で引ける。
+ * add_arc で弧を積んだ後 build() で並べ直す。clear() してもバッファは解放しないので、
+ * 同じインスタンスを使い回せば再確保は起こらない。
+ *
+ * @tparam CapacityType capacity type
+ */
+template <typename CapacityType>
+class ResidualGraph
+{
+public:
+    void clear(const std::size_t n)
+    {
+        size_ = n;
+        staged_from_.clear();
+        staged_to_.clear();
+        staged_capacity_.clear();
+    }
+
+    /**
+     * @brief from -> to に容量 capacity、逆向きに容量 reverse_capacity の弧の組を張る
+     *
+     * @return 追加した弧の組の番号 (build 後は arc_id() で弧番号に変換する)
+     */
+    std::size_t add_arc(const std::size_t from, const std::size_t to, const CapacityType capacity, const CapacityType reverse_capacity = CapacityType(0))
+    {
+        staged_from_.push_back(from);
+        staged_to_.push_back(to);
+        staged_capacity_.push_back(capacity);
+        staged_from_.push_back(to);
+        staged_to_.push_back(from);
+        staged_capacity_.push_back(reverse_capacity);
+        return staged_from_.size() / 2 - 1;
+    }
+
+    /**
+     * @brief グラフの各辺を弧に変換して組み立てる。無向辺は両向きに同じ容量を持つ
+     */
+    template <typename GraphType>
+    void assign(const GraphType& graph)
+    {
+        clear(graph.size());
+        for (std::size_t v = 0; v < graph.size(); v++)
+        {
+            for (const auto& adj : graph.adjacent(v))
+            {
+                const std::size_t nv = adj.first;
+                const CapacityType capacity = static_cast<CapacityType>(graph.edge_at(adj.second));
+                if (!graph.undirected())
+                {
+                    add_arc(v, nv, capacity);
+                }
+                else if (v < nv)
+                {
+                    add_arc(v, nv, capacity, capacity);
+                }
+            }
+        }
+        build();
+    }
+
+    // 積んだ弧を始点ごとに並べ直す (計数ソート)
+    void build()
+    {
+        const std::size_t m = staged_from_.size();
+
+        offsets_.assign(size_ + 1, 0);
+        for (std::size_t i = 0; i < m; i++)
+        {
+            offsets_[staged_from_[i] + 1]++;
+        }
+        for (std::size_t v = 0; v < size_; v++)
+        {
+            offsets_[v + 1] += offsets_[v];
+        }
+
+        position_.resize(m);
+        to_.resize(m);
+        capacity_.resize(m);
+        original_.resize(m);
+        reverse_.resize(m);
+
+        cursor_.assign(offsets_.begin(), offsets_.end() - 1);
+        for (std::size_t i = 0; i < m; i++)
+        {
+            position_[i] = cursor_[staged_from_[i]]++;
+        }
+        for (std::size_t i = 0; i < m; i++)
+        {
+            const std::size_t e = position_[i];
+            to_[e] = staged_to_[i];
+            capacity_[e] = staged_capacity_[i];
+            original_[e] = staged_capacity_[i];
+            reverse_[e] = position_[i ^ 1];
+        }
+    }
+
+    /**
+     * @brief add_arc が返した番号 -> 順方向の弧番号
+     */
+    std::size_t arc_id(const std::size_t pair_id) const noexcept
+    {
+        return position_[pair_id * 2];
+    }
+
+    // 容量を add_arc / assign した直後の値に戻す
+    void reset_capacity()
+    {
+        capacity_ = original_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    std::size_t arc_size() const noexcept
+    {
+        return to_.size();
+    }
+
+    // v から出る弧は [first_arc(v), last_arc(v))
+    std::size_t first_arc(const std::size_t v) const noexcept
+    {
+        return offsets_[v];
+    }
+
+    std::size_t last_arc(const std::size_t v) const noexcept
+    {
+        return offsets_[v + 1];
+    }
+
+    std::size_t to(const std::size_t e) const noexcept
+    {
+        return to_[e];
+    }
+
+    std::size_t from(const std::size_t e) const noexcept
+    {
+        return to_[reverse_[e]];
+    }
+
+    std::size_t reverse(const std::size_t e) const noexcept
+    {
+        return reverse_[e];
+    }
+
+    CapacityType& capacity(const std::size_t e) noexcept
+    {
+        return capacity_[e];
+    }
+
+    const CapacityType& capacity(const std::size_t e) const noexcept
+    {
+        return capacity_[e];
+    }
+
+    /**
+     * @brief 弧 e に流れている量 (逆向きの流量は負になる)
+     */
+    CapacityType flow(const std::size_t e) const noexcept
+    {
+        return original_[e] - capacity_[e];
+    }
+
+    // e の容量を f 減らし、逆弧の容量を f 増やす
+    void push(const std::size_t e, const CapacityType f) noexcept
+    {
+        capacity_[e] -= f;
+        capacity_[reverse_[e]] += f;
+    }
+
+private:
+    std::size_t size_ = 0;
+
+    std::vector<std::size_t> staged_from_;
+    std::vector<std::size_t> staged_to_;
+    std::vector<CapacityType> staged_capacity_;
+
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> cursor_;
+    std::vector<std::size_t> position_;
+
+    std::vector<std::size_t> to_;
+    std::vector<std::size_t> reverse_;
+    std::vector<CapacityType> capacity_;
+    std::vector<CapacityType> original_;
+};
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <limits>
 #include <queue>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "../data_structure/dary_heap.hpp"
+#include "../data_structure/pairing_heap.hpp"
+#include "../data_structure/radix_heap.hpp"
 #include "base.hpp"
 
-// verified: https://atcoder.jp/contests/abc051/tasks/abc051_d
 template <typename GraphType>
 std::vector<std::vector<int>> warshall_floyd(const GraphType& graph)
 {
@@ -19,9 +26,9 @@ std::vector<std::vector<int>> warshall_floyd(const GraphType& graph)
     for (int i = 0; i < n; i++)
     {
         distance[i][i] = 0;
-        for (auto j : graph.neighbor(i))
+        for (const auto& adj : graph.adjacent(i))
         {
-            distance[i][j] = graph.edge(i, j);
+            distance[i][adj.first] = graph.edge_at(adj.second);
         }
     }
     for (std::size_t k = 0; k < n; k++)
@@ -37,28 +44,395 @@ std::vector<std::vector<int>> warshall_floyd(const GraphType& graph)
     return distance;
 }
 
-template <typename NodeType, typename EdgeType, typename CostType>
-CostType dijkstra(const SparseGraph<NodeType, EdgeType>& graph, std::size_t start, std::size_t goal)
+/**
+ * @brief 単一始点最短路の結果
+ * parent は最短路木での親。始点と到達できない頂点は None()
+ */
+template <typename CostType>
+struct ShortestPathTree
 {
-    using elem_type = std::pair<std::int64_t, std::int64_t>;
-    std::priority_queue<elem_type, std::vector<elem_type>, less<elem_type>> que;
+    static constexpr CostType Infinity()
+    {
+        return std::numeric_limits<CostType>::max();
+    }
 
-    std::vector<CostType> cost(graph.size(), std::numeric_limits<CostType>::max());
+    static constexpr std::size_t None()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
 
-    while (!que.size())
+    void reset(const std::size_t n)
     {
-        std::int64_t node;
-        CostType c;
-        std::tie(node, c) = que.top();
-        que.pop();
+        distance.assign(n, Infinity());
+        parent.assign(n, None());
+    }
 
-        if (cost[node] > c)
+    bool reachable(const std::size_t v) const noexcept
+    {
+        return distance[v] != Infinity();
+    }
+
+    /**
+     * @brief 始点から goal までの頂点列。到達できなければ空
+     */
+    std::vector<std::size_t> path(std::size_t goal) const
+    {
+        std::vector<std::size_t> ret;
+        if (!reachable(goal))
         {
-            cost[node] = c;
-            for (auto next : graph.neighbor(node))
+            return ret;
+        }
+        for (; goal != None(); goal = parent[goal])
+        {
+            ret.push_back(goal);
+        }
+        std::reverse(ret.begin(), ret.end());
+        return ret;
+    }
+
+    std::vector<CostType> distance;
+    std::vector<std::size_t> parent;
+};
+
+// Dijkstra のキュー。push(v, d) は v の暫定距離が d に下がったことを伝え、pop は (距離, 頂点) を返す。
+// 遅延削除のキューは古い要素も返すので、呼び出し側で distance と比べて捨てる。
+
+// std::priority_queue 相当の二分ヒープ (遅延削除)
+template <typename CostType>
+class BinaryHeapQueue
+{
+public:
+    void reset(const std::size_t)
+    {
+        heap_.clear();
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    void push(const std::size_t v, const CostType d)
+    {
+        heap_.emplace_back(d, v);
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+    }
+
+    std::pair<CostType, std::size_t> pop()
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+        const auto ret = heap_.back();
+        heap_.pop_back();
+        return ret;
+    }
+
+private:
+    using Element = std::pair<CostType, std::size_t>;
+    std::vector<Element> heap_;
+};
+
+// 4-ary heap (decrease-key)
+template <typename CostType>
+class DaryHeapQueue
+{
+public:
+    void reset(const std::size_t n)
+    {
+        heap_.reset(n);
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    void push(const std::size_t v, const CostType d)
+    {
+        heap_.push(v, d);
+    }
+
+    std::pair<CostType, std::size_t> pop()
+    {
+        const std::size_t v = heap_.pop();
+        return std::make_pair(heap_.key(v), v);
+    }
+
+private:
+    DaryHeap<CostType, 4> heap_;
+};
+
+// pairing heap (decrease-key)
+template <typename CostType>
+class PairingHeapQueue
+{
+public:
+    void reset(const std::size_t n)
+    {
+        heap_.reset(n);
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    void push(const std::size_t v, const CostType d)
+    {
+        heap_.push(v, d);
+    }
+
+    std::pair<CostType, std::size_t> pop()
+    {
+        const std::size_t v = heap_.pop();
+        return std::make_pair(heap_.key(v), v);
+    }
+
+private:
+    PairingHeap<CostType> heap_;
+};
+
+// radix heap (遅延削除)。非負整数の重み専用
+template <typename CostType>
+class RadixHeapQueue
+{
+public:
+    void reset(const std::size_t)
+    {
+        heap_.clear();
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    void push(const std::size_t v, const CostType d)
+    {
+        heap_.push(d, v);
+    }
+
+    std::pair<CostType, std::size_t> pop()
+    {
+        return heap_.pop();
+    }
+
+private:
+    RadixHeap<CostType, std::size_t> heap_;
+};
+
+/**
+ * @brief Dijkstra 法の本体。goal を取り出した時点で打ち切る (goal = None() なら全頂点)
+ */
+template <typename GraphType, typename QueueType>
+void dijkstra(const GraphType& graph, const std::size_t start, const std::size_t goal, QueueType& que, ShortestPathTree<typename GraphType::EdgeType>& tree)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    tree.reset(graph.size());
+    que.reset(graph.size());
+
+    tree.distance[start] = 0;
+    que.push(start, 0);
+    while (!que.empty())
+    {
+        CostType d;
+        std::size_t v;
+        std::tie(d, v) = que.pop();
+        if (tree.distance[v] < d)
+        {
+            continue;
+        }
+        if (v == goal)
+        {
+            break;
+        }
+
+        for (const auto& adj : graph.adjacent(v))
+        {
+            const auto nv = adj.first;
+            const CostType nd = d + graph.edge_at(adj.second);
+            if (nd < tree.distance[nv])
+            {
+                tree.distance[nv] = nd;
+                tree.parent[nv] = v;
+                que.push(nv, nd);
+            }
+        }
+    }
+}
+
+/**
+ * @brief start からの単一始点最短路 (重みは非負)
+ * 例: dijkstra<RadixHeapQueue>(graph, s)
+ *
+ * @tparam Queue BinaryHeapQueue / DaryHeapQueue / PairingHeapQueue / RadixHeapQueue
+ */
+template <template <typename> class Queue = BinaryHeapQueue, typename GraphType>
+ShortestPathTree<typename GraphType::EdgeType> dijkstra(const GraphType& graph, const std::size_t start)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    ShortestPathTree<CostType> tree;
+    Queue<CostType> que;
+    dijkstra(graph, start, ShortestPathTree<CostType>::None(), que, tree);
+    return tree;
+}
+
+/**
+ * @brief start から goal までの最短距離。goal に着いた時点で打ち切る。到達できなければ Infinity()
+ */
+template <template <typename> class Queue = BinaryHeapQueue, typename GraphType>
+typename GraphType::EdgeType dijkstra(const GraphType& graph, const std::size_t start, const std::size_t goal)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    ShortestPathTree<CostType> tree;
+    Queue<CostType> que;
+    dijkstra(graph, start, goal, que, tree);
+    return tree.distance[goal];
+}
+
+/**
+ * @brief 重みを無視して (全て 1 とみなして) 幅優先探索で求めた最短路
+ */
+template <typename GraphType>
+ShortestPathTree<typename GraphType::EdgeType> bfs(const GraphType& graph, const std::size_t start)
+{
+    ShortestPathTree<typename GraphType::EdgeType> tree;
+    tree.reset(graph.size());
+
+    std::vector<std::size_t> que;
+    que.reserve(graph.size());
+    que.push_back(start);
+    tree.distance[start] = 0;
+    for (std::size_t i = 0; i < que.size(); i++)
+    {
+        const auto v = que[i];
+        for (const auto nv : graph.neighbor(v))
+        {
+            if (!tree.reachable(nv))
+            {
+                tree.distance[nv] = tree.distance[v] + 1;
+                tree.parent[nv] = v;
+                que.push_back(nv);
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief 重みが 0 か 1 のグラフの単一始点最短路 (0-1 BFS, O(V + E))
+ */
+template <typename GraphType>
+ShortestPathTree<typename GraphType::EdgeType> bfs01(const GraphType& graph, const std::size_t start)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    ShortestPathTree<CostType> tree;
+    tree.reset(graph.size());
+
+    std::vector<bool> finished(graph.size(), false);
+    std::deque<std::size_t> que;
+    que.push_back(start);
+    tree.distance[start] = 0;
+    while (!que.empty())
+    {
+        const auto v = que.front();
+        que.pop_front();
+        if (finished[v])
+        {
+            continue;
+        }
+        finished[v] = true;
+
+        for (const auto& adj : graph.adjacent(v))
+        {
+            const auto nv = adj.first;
+            const CostType w = graph.edge_at(adj.second);
+            assert(w == 0 || w == 1);
+            const CostType nd = tree.distance[v] + w;
+            if (nd < tree.distance[nv])
             {
-                if ()
+                tree.distance[nv] = nd;
+                tree.parent[nv] = v;
+                if (w == 0)
+                {
+                    que.push_front(nv);
+                }
+                else
+                {
+                    que.push_back(nv);
+                }
             }
         }
     }
-}
\ No newline at end of file
+    return tree;
+}
+
+/**
+ * @brief 重みが 0 以上 max_weight 以下の整数のグラフの単一始点最短路 (Dial, O(V + E + 最短距離))
+ * 距離 mod (max_weight + 1) のバケツを循環させて使う。
+ */
+template <typename GraphType>
+ShortestPathTree<typename GraphType::EdgeType> dial(const GraphType& graph, const std::size_t start, const typename GraphType::EdgeType max_weight)
+{
+    using CostType = typename GraphType::EdgeType;
+
+    ShortestPathTree<CostType> tree;
+    tree.reset(graph.size());
+
+    const std::size_t bucket_size = static_cast<std::size_t>(max_weight) + 1;
+    std::vector<std::vector<std::size_t>> buckets(bucket_size);
+    std::size_t pending = 1;
+    buckets[0].push_back(start);
+    tree.distance[start] = 0;
+
+    for (CostType d = 0; pending > 0; d++)
+    {
+        auto& bucket = buckets[static_cast<std::size_t>(d) % bucket_size];
+        while (!bucket.empty())
+        {
+            const auto v = bucket.back();
+            bucket.pop_back();
+            pending--;
+            if (tree.distance[v] != d)
+            {
+                continue;
+            }
+
+            for (const auto& adj : graph.adjacent(v))
+            {
+                const auto nv = adj.first;
+                const CostType w = graph.edge_at(adj.second);
+                assert(0 <= w && w <= max_weight);
+                const CostType nd = d + w;
+                if (nd < tree.distance[nv])
+                {
+                    tree.distance[nv] = nd;
+                    tree.parent[nv] = v;
+                    buckets[static_cast<std::size_t>(nd) % bucket_size].push_back(nv);
+                    pending++;
+                }
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief 重みの最大値を走査してから Dial で解く
+ */
+template <typename GraphType>
+ShortestPathTree<typename GraphType::EdgeType> dial(const GraphType& graph, const std::size_t start)
+{
+    typename GraphType::EdgeType max_weight = 0;
+    for (std::size_t v = 0; v < graph.size(); v++)
+    {
+        for (const auto& adj : graph.adjacent(v))
+        {
+            max_weight = std::max(max_weight, graph.edge_at(adj.second));
+        }
+    }
+    return dial(graph, start, max_weight);
+}
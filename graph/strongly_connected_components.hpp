@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base.hpp"
+
+/**
+ * @brief 強連結成分分解 (非再帰の Tarjan 法, O(V + E))
+ * 成分番号はトポロジカル順 (u -> v の辺があれば component(u) <= component(v)) に振る。
+ * 再帰しないので、10^6 頂点の一本道でもスタックは溢れない。作業領域は build() ごとに使い回す。
+ */
+class StronglyConnectedComponents
+{
+public:
+    StronglyConnectedComponents() = default;
+
+    template <typename GraphType>
+    explicit StronglyConnectedComponents(const GraphType& graph)
+    {
+        build(graph);
+    }
+
+    /**
+     * @brief graph を分解する
+     *
+     * @return 成分の数
+     */
+    template <typename GraphType>
+    std::size_t build(const GraphType& graph)
+    {
+        using Iterator = decltype(graph.neighbor(0).begin());
+
+        const std::size_t n = graph.size();
+        index_.assign(n, Unvisited());
+        low_.resize(n);
+        component_.assign(n, Unvisited());
+        stack_.clear();
+        component_size_ = 0;
+
+        std::vector<std::pair<std::size_t, Iterator>> call_stack;
+        std::size_t next_index = 0;
+        for (std::size_t root = 0; root < n; root++)
+        {
+            if (index_[root] != Unvisited())
+            {
+                continue;
+            }
+
+            index_[root] = low_[root] = next_index++;
+            stack_.push_back(root);
+            call_stack.emplace_back(root, graph.neighbor(root).begin());
+            while (!call_stack.empty())
+            {
+                const std::size_t v = call_stack.back().first;
+                auto& it = call_stack.back().second;
+                if (it != graph.neighbor(v).end())
+                {
+                    const std::size_t nv = *it;
+                    ++it;
+                    if (index_[nv] == Unvisited())
+                    {
+                        index_[nv] = low_[nv] = next_index++;
+                        stack_.push_back(nv);
+                        call_stack.emplace_back(nv, graph.neighbor(nv).begin());
+                    }
+                    else if (component_[nv] == Unvisited())
+                    {
+                        // nv はまだ stack_ 上にある
+                        low_[v] = std::min(low_[v], index_[nv]);
+                    }
+                    continue;
+                }
+
+                // v の子を全て見終わった
+                call_stack.pop_back();
+                if (!call_stack.empty())
+                {
+                    const std::size_t parent = call_stack.back().first;
+                    low_[parent] = std::min(low_[parent], low_[v]);
+                }
+                if (low_[v] == index_[v])
+                {
+                    while (true)
+                    {
+                        const std::size_t u = stack_.back();
+                        stack_.pop_back();
+                        component_[u] = component_size_;
+                        if (u == v)
+                        {
+                            break;
+                        }
+                    }
+                    component_size_++;
+                }
+            }
+        }
+
+        // Tarjan 法は逆トポロジカル順に成分を見つけるので反転する
+        for (auto& c : component_)
+        {
+            c = component_size_ - 1 - c;
+        }
+        return component_size_;
+    }
+
+    // 頂点 v の成分番号
+    std::size_t component(const std::size_t v) const noexcept
+    {
+        return component_[v];
+    }
+
+    const std::vector<std::size_t>& components() const noexcept
+    {
+        return component_;
+    }
+
+    // 成分の数
+    std::size_t size() const noexcept
+    {
+        return component_size_;
+    }
+
+    /**
+     * @brief 成分ごとの頂点の列 (成分番号順)
+     */
+    std::vector<std::vector<std::size_t>> groups() const
+    {
+        std::vector<std::vector<std::size_t>> ret(component_size_);
+        for (std::size_t v = 0; v < component_.size(); v++)
+        {
+            ret[component_[v]].push_back(v);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 成分を 1 頂点に縮めた DAG (有向の SparseGraph)
+     * 頂点の値は成分の頂点数、辺の重みは成分間を結ぶ元の辺の本数。成分内の辺は捨てる。
+     */
+    template <typename GraphType>
+    SparseGraph<std::size_t, std::size_t> condensation(const GraphType& graph) const
+    {
+        SparseGraph<std::size_t, std::size_t> dag(false);
+        for (std::size_t c = 0; c < component_size_; c++)
+        {
+            dag.push_node(0);
+        }
+        for (std::size_t v = 0; v < graph.size(); v++)
+        {
+            const std::size_t from = component_[v];
+            dag.node(from)++;
+            for (const auto nv : graph.neighbor(v))
+            {
+                const std::size_t to = component_[nv];
+                if (from == to)
+                {
+                    continue;
+                }
+                const auto it = dag.adjacent(from).find(to);
+                if (it == dag.adjacent(from).end())
+                {
+                    dag.connect(from, to, 1);
+                }
+                else
+                {
+                    dag.edge_at(it->second)++;
+                }
+            }
+        }
+        return dag;
+    }
+
+private:
+    static constexpr std::size_t Unvisited()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    // 訪問順
+    std::vector<std::size_t> index_;
+
+    // 部分木から stack_ 上の頂点へ辿れる最小の訪問順
+    std::vector<std::size_t> low_;
+
+    std::vector<std::size_t> component_;
+
+    // 成分が確定していない頂点
+    std::vector<std::size_t> stack_;
+
+    std::size_t component_size_ = 0;
+};
@@ -1,52 +1,188 @@
 #pragma once
 
-#include <stack>
-#include <tuple>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "base.hpp"
-// verified @ https://nikkei2019-qual.contest.atcoder.jp/tasks/nikkei2019_qual_d
-template <typename GraphType>
-std::vector<std::size_t> topological_order(const GraphType& graph)
+
+/**
+ * @brief 作業領域を使い回すトポロジカルソート (Kahn 法)
+ * 入次数 0 の頂点の集合 (frontier) を 1 段ずつ取り除くので、order() は段の順に並び、
+ * level(i) で i 段目の頂点を取り出せる。同じ段の頂点の間には依存がないので並列に処理できる。
+ * 閉路があれば sort() は false を返し、cycle() に閉路を 1 つ入れる。
+ * 2 回目以降の sort() は、頂点数と辺数が前回以下ならメモリを確保しない (閉路の検出時を除く)。
+ */
+class TopologicalSorter
 {
-    std::vector<std::size_t> order;
-    stack<int> st;
+public:
+    /**
+     * @brief graph をトポロジカルソートする
+     *
+     * @return DAG なら true。false のときの order() は閉路に関わらない頂点だけ
+     */
+    template <typename GraphType>
+    bool sort(const GraphType& graph)
+    {
+        const std::size_t n = graph.size();
+        in_degree_.assign(n, 0);
+        order_.clear();
+        level_offsets_.clear();
+        cycle_.clear();
 
-    vector<int> hs(graph.size());
+        for (std::size_t v = 0; v < n; v++)
+        {
+            for (const auto nv : graph.neighbor(v))
+            {
+                in_degree_[nv]++;
+            }
+        }
+        for (std::size_t v = 0; v < n; v++)
+        {
+            if (in_degree_[v] == 0)
+            {
+                order_.push_back(v);
+            }
+        }
 
-    for (int v = 0; v < graph.size(); v++)
-    {
-        for (int nv : graph.neighbor(v))
+        // order_ をキューとして使い、[level_begin, level_end) の段から次の段を作る
+        std::size_t level_begin = 0;
+        while (level_begin < order_.size())
         {
-            hs[nv]++;
+            const std::size_t level_end = order_.size();
+            level_offsets_.push_back(level_begin);
+            for (std::size_t i = level_begin; i < level_end; i++)
+            {
+                for (const auto nv : graph.neighbor(order_[i]))
+                {
+                    if (--in_degree_[nv] == 0)
+                    {
+                        order_.push_back(nv);
+                    }
+                }
+            }
+            level_begin = level_end;
         }
-    }
-    for (int i = 0; i < graph.size(); i++)
-    {
-        if (hs[i] == 0)
+        level_offsets_.push_back(order_.size());
+
+        if (order_.size() == n)
         {
-            st.push(i);
+            return true;
         }
+        find_cycle(graph);
+        return false;
+    }
+
+    /**
+     * @brief 直前の sort() の結果。段の順に並んでいる
+     */
+    const std::vector<std::size_t>& order() const noexcept
+    {
+        return order_;
     }
 
-    vector<int> finished(graph.size(), false);
+    // 段数
+    std::size_t level_size() const noexcept
+    {
+        return level_offsets_.size() - 1;
+    }
+
+    /**
+     * @brief i 段目の頂点。i 段目の頂点は i - 1 段目までの頂点だけに依存する
+     */
+    Range<const std::size_t*> level(const std::size_t i) const noexcept
+    {
+        return Range<const std::size_t*>(order_.data() + level_offsets_[i], order_.data() + level_offsets_[i + 1]);
+    }
 
-    while (!st.empty())
+    /**
+     * @brief sort() が false のときの閉路 v_0 -> v_1 -> ... -> v_k -> v_0。DAG なら空
+     */
+    const std::vector<std::size_t>& cycle() const noexcept
     {
-        const int v = st.top();
-        st.pop();
-        order.push_back(v);
-        finished[v] = true;
+        return cycle_;
+    }
 
-        for (int nv : graph.neighbor(v))
+private:
+    std::vector<std::size_t> in_degree_;
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> level_offsets_;
+    std::vector<std::size_t> cycle_;
+
+    /**
+     * @brief 取り除けなかった頂点 (in_degree_ > 0) の中を非再帰 DFS して後退辺を探す
+     * in_degree_ を DFS の状態 (0: 取り除いた / 未訪問, 1: 探索中, 2: 探索済み) に書き換える。
+     */
+    template <typename GraphType>
+    void find_cycle(const GraphType& graph)
+    {
+        constexpr std::size_t Removed = 0;
+        constexpr std::size_t Active = 1;
+        constexpr std::size_t Finished = 2;
+        constexpr std::size_t Unvisited = 3;
+
+        const std::size_t n = graph.size();
+        for (std::size_t v = 0; v < n; v++)
         {
-            hs[nv]--;
-            if (hs[nv] == 0 && !finished[nv])
+            in_degree_[v] = in_degree_[v] == 0 ? Removed : Unvisited;
+        }
+
+        using Iterator = decltype(graph.neighbor(0).begin());
+        std::vector<std::pair<std::size_t, Iterator>> stack;
+        for (std::size_t root = 0; root < n; root++)
+        {
+            if (in_degree_[root] != Unvisited)
             {
-                st.push(nv);
+                continue;
+            }
+            in_degree_[root] = Active;
+            stack.emplace_back(root, graph.neighbor(root).begin());
+            while (!stack.empty())
+            {
+                const std::size_t v = stack.back().first;
+                auto& it = stack.back().second;
+                if (it == graph.neighbor(v).end())
+                {
+                    in_degree_[v] = Finished;
+                    stack.pop_back();
+                    continue;
+                }
+
+                const std::size_t nv = *it;
+                ++it;
+                if (in_degree_[nv] == Unvisited)
+                {
+                    in_degree_[nv] = Active;
+                    stack.emplace_back(nv, graph.neighbor(nv).begin());
+                }
+                else if (in_degree_[nv] == Active)
+                {
+                    // stack 上の nv から v までが閉路
+                    auto first = std::find_if(stack.begin(), stack.end(), [nv](const std::pair<std::size_t, Iterator>& e) {
+                        return e.first == nv;
+                    });
+                    for (; first != stack.end(); ++first)
+                    {
+                        cycle_.push_back(first->first);
+                    }
+                    return;
+                }
             }
         }
     }
-    assert(order.size() == graph.size());
-    return order;
-}
\ No newline at end of file
+};
+
+/**
+ * @brief トポロジカル順序。閉路があれば空
+ */
+template <typename GraphType>
+std::vector<std::size_t> topological_order(const GraphType& graph)
+{
+    TopologicalSorter sorter;
+    if (!sorter.sort(graph))
+    {
+        return std::vector<std::size_t>();
+    }
+    return sorter.order();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "strongly_connected_components.hpp"
+
+/**
+ * @brief 2-SAT
+ * 変数 x_i のリテラル (x_i = true) を頂点 2i、(x_i = false) を頂点 2i + 1 とした含意グラフを作り、
+ * 強連結成分分解で充足可能性と解を求める (O(変数 + 節))。
+ */
+class TwoSat
+{
+public:
+    explicit TwoSat(const std::size_t n = 0)
+        : size_(n)
+    {
+    }
+
+    void clear(const std::size_t n)
+    {
+        size_ = n;
+        clauses_.clear();
+    }
+
+    /**
+     * @brief 節 (x_i = f) or (x_j = g) を加える
+     */
+    void add_clause(const std::size_t i, const bool f, const std::size_t j, const bool g)
+    {
+        assert(i < size_ && j < size_);
+        clauses_.emplace_back(literal(i, !f), literal(j, g), 1);
+        clauses_.emplace_back(literal(j, !g), literal(i, f), 1);
+    }
+
+    /**
+     * @brief 充足可能か判定し、可能なら answer() に解を入れる
+     */
+    bool satisfiable()
+    {
+        std::vector<std::size_t> nodes(2 * size_);
+        const CSRGraph<std::size_t, std::size_t> graph(std::move(nodes), clauses_, false);
+        scc_.build(graph);
+
+        answer_.assign(size_, false);
+        for (std::size_t i = 0; i < size_; i++)
+        {
+            const std::size_t t = scc_.component(literal(i, true));
+            const std::size_t f = scc_.component(literal(i, false));
+            if (t == f)
+            {
+                return false;
+            }
+            // トポロジカル順で後ろにある方を真にする
+            answer_[i] = t > f;
+        }
+        return true;
+    }
+
+    const std::vector<bool>& answer() const noexcept
+    {
+        return answer_;
+    }
+
+    // 変数の数
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    static std::size_t literal(const std::size_t i, const bool value) noexcept
+    {
+        return 2 * i + (value ? 0 : 1);
+    }
+
+    std::size_t size_;
+
+    // 含意 (from -> to) の列
+    CSRGraph<std::size_t, std::size_t>::EdgeListType clauses_;
+
+    StronglyConnectedComponents scc_;
+
+    std::vector<bool> answer_;
+};
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 struct UnionFind
@@ -63,4 +69,381 @@ struct UnionFind
         auto ry = Root(y);
         return rx == ry;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief 1 要素あたり sizeof(IndexType) バイトの UnionFind
+ * _data[x] は x が根なら -(集合の大きさ)、そうでなければ親。
+ * Root は非再帰の path halving、Unite は大きさの小さい方を付ける。
+ *
+ * @tparam IndexType 符号付き整数。要素数は IndexType の最大値以下
+ */
+template <typename IndexType = std::int32_t>
+class CompactUnionFind
+{
+public:
+    static_assert(std::is_signed<IndexType>::value, "IndexType must be signed");
+
+    CompactUnionFind(std::size_t N)
+        : _data(N, -1)
+    {
+        assert(N <= static_cast<std::size_t>(std::numeric_limits<IndexType>::max()));
+    }
+
+    std::size_t Root(std::size_t x)
+    {
+        IndexType v = static_cast<IndexType>(x);
+        while (_data[v] >= 0)
+        {
+            const IndexType p = _data[v];
+            if (_data[p] >= 0)
+            {
+                // 親を祖父に付け替えて 2 段ずつ登る
+                _data[v] = _data[p];
+            }
+            v = _data[v];
+        }
+        return static_cast<std::size_t>(v);
+    }
+
+    /**
+     * @return x と y が別の集合だったら true
+     */
+    bool Unite(std::size_t x, std::size_t y)
+    {
+        auto rx = Root(x);
+        auto ry = Root(y);
+        if (rx == ry)
+        {
+            return false;
+        }
+        if (_data[rx] > _data[ry])
+        {
+            std::swap(rx, ry);
+        }
+        _data[rx] += _data[ry];
+        _data[ry] = static_cast<IndexType>(rx);
+        return true;
+    }
+
+    std::size_t Size(std::size_t x)
+    {
+        return static_cast<std::size_t>(-_data[Root(x)]);
+    }
+
+    bool Same(std::size_t x, std::size_t y)
+    {
+        return Root(x) == Root(y);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _data.size();
+    }
+
+private:
+    std::vector<IndexType> _data;
+};
+
+/**
+ * @brief 要素間の差 (ポテンシャル) を持つ UnionFind
+ * Weight(x) は根から見た x の値で、Unite(x, y, w) は「y の値 - x の値 = w」という制約を加える。
+ * Root は非再帰の経路圧縮で、圧縮しながら Weight も根からの差に付け替える。
+ *
+ * @tparam T 差の型 (加減算ができる群)
+ */
+template <typename T>
+class WeightedUnionFind
+{
+public:
+    WeightedUnionFind(std::size_t N)
+        : _par(N)
+        , _size(N, 1)
+        , _diff(N, T())
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            _par[i] = i;
+        }
+    }
+
+    std::size_t Root(std::size_t x)
+    {
+        std::size_t root = x;
+        while (_par[root] != root)
+        {
+            root = _par[root];
+        }
+
+        // x から根までの差の総和を求めてから、根に近い側へ向かって付け替える
+        T total = T();
+        for (std::size_t v = x; v != root; v = _par[v])
+        {
+            total += _diff[v];
+        }
+        while (x != root)
+        {
+            const std::size_t next = _par[x];
+            const T d = _diff[x];
+            _par[x] = root;
+            _diff[x] = total;
+            total -= d;
+            x = next;
+        }
+        return root;
+    }
+
+    // 根から見た x の値
+    T Weight(std::size_t x)
+    {
+        Root(x);
+        return _diff[x];
+    }
+
+    /**
+     * @brief y の値 - x の値。同じ集合でなければ意味を持たない
+     */
+    T Diff(std::size_t x, std::size_t y)
+    {
+        assert(Same(x, y));
+        return Weight(y) - Weight(x);
+    }
+
+    /**
+     * @brief 制約 (y の値 - x の値 = w) を加える
+     *
+     * @return 新たに併合したら true。既に同じ集合なら何もせず false (矛盾は Diff で確かめる)
+     */
+    bool Unite(std::size_t x, std::size_t y, T w)
+    {
+        auto rx = Root(x);
+        auto ry = Root(y);
+        if (rx == ry)
+        {
+            return false;
+        }
+
+        // ry の値 - rx の値
+        w += _diff[x];
+        w -= _diff[y];
+        if (_size[rx] < _size[ry])
+        {
+            std::swap(rx, ry);
+            w = -w;
+        }
+        _par[ry] = rx;
+        _diff[ry] = w;
+        _size[rx] += _size[ry];
+        return true;
+    }
+
+    std::size_t Size(std::size_t x)
+    {
+        return _size[Root(x)];
+    }
+
+    bool Same(std::size_t x, std::size_t y)
+    {
+        return Root(x) == Root(y);
+    }
+
+private:
+    std::vector<std::size_t> _par;
+    std::vector<std::size_t> _size;
+
+    // 親から見た値
+    std::vector<T> _diff;
+};
+
+/**
+ * @brief 操作を巻き戻せる UnionFind
+ * 経路圧縮をせず大きさで併合するので Root は O(log N)。Unite で書き換えた値を履歴に積み、
+ * snapshot() で取った時点まで rollback() で戻す。
+ *
+ * @tparam IndexType 符号付き整数。要素数は IndexType の最大値以下
+ */
+template <typename IndexType = std::int32_t>
+class RollbackUnionFind
+{
+public:
+    static_assert(std::is_signed<IndexType>::value, "IndexType must be signed");
+
+    RollbackUnionFind(std::size_t N)
+        : _data(N, -1)
+        , _count(N)
+    {
+        assert(N <= static_cast<std::size_t>(std::numeric_limits<IndexType>::max()));
+    }
+
+    std::size_t Root(std::size_t x) const
+    {
+        while (_data[x] >= 0)
+        {
+            x = static_cast<std::size_t>(_data[x]);
+        }
+        return x;
+    }
+
+    /**
+     * @return x と y が別の集合だったら true
+     */
+    bool Unite(std::size_t x, std::size_t y)
+    {
+        auto rx = Root(x);
+        auto ry = Root(y);
+        if (rx == ry)
+        {
+            return false;
+        }
+        if (_data[rx] > _data[ry])
+        {
+            std::swap(rx, ry);
+        }
+        _history.emplace_back(rx, _data[rx]);
+        _history.emplace_back(ry, _data[ry]);
+        _data[rx] += _data[ry];
+        _data[ry] = static_cast<IndexType>(rx);
+        _count--;
+        return true;
+    }
+
+    std::size_t Size(std::size_t x) const
+    {
+        return static_cast<std::size_t>(-_data[Root(x)]);
+    }
+
+    bool Same(std::size_t x, std::size_t y) const
+    {
+        return Root(x) == Root(y);
+    }
+
+    // 集合の数
+    std::size_t Count() const noexcept
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 現在の状態を表す値。rollback に渡すとこの状態に戻る
+     */
+    std::size_t snapshot() const noexcept
+    {
+        return _history.size();
+    }
+
+    void rollback(const std::size_t state)
+    {
+        assert(state <= _history.size());
+        while (_history.size() > state)
+        {
+            // 1 回の Unite で 2 つ積んでいる
+            for (int i = 0; i < 2; i++)
+            {
+                _data[_history.back().first] = _history.back().second;
+                _history.pop_back();
+            }
+            _count++;
+        }
+    }
+
+private:
+    std::vector<IndexType> _data;
+
+    // (書き換えた位置, 元の値)
+    std::vector<std::pair<std::size_t, IndexType>> _history;
+
+    std::size_t _count;
+};
+
+/**
+ * @brief 複数スレッドから同時に Unite / Same を呼べる UnionFind (ロックなし)
+ * 根の付け替えは compare-and-swap で行い、Root は path splitting (親を祖父に CAS で付け替えながら登る) で木を縮める。
+ * 付け替えは番号の大きい根を小さい根の下にする。Size は持たない。
+ */
+class ConcurrentUnionFind
+{
+public:
+    ConcurrentUnionFind(std::size_t N)
+        : _par(N)
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            _par[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t Root(std::size_t x)
+    {
+        while (true)
+        {
+            std::size_t p = _par[x].load(std::memory_order_acquire);
+            if (p == x)
+            {
+                return x;
+            }
+            const std::size_t gp = _par[p].load(std::memory_order_acquire);
+            if (p != gp)
+            {
+                // 失敗しても他のスレッドが x の親を根に近づけただけなので気にしない
+                _par[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel, std::memory_order_relaxed);
+            }
+            x = p;
+        }
+    }
+
+    /**
+     * @return x と y が別の集合だったら true
+     */
+    bool Unite(std::size_t x, std::size_t y)
+    {
+        while (true)
+        {
+            auto rx = Root(x);
+            auto ry = Root(y);
+            if (rx == ry)
+            {
+                return false;
+            }
+            if (rx > ry)
+            {
+                std::swap(rx, ry);
+            }
+            // ry がまだ根なら rx の下に付ける。他のスレッドに先を越されたらやり直す
+            std::size_t expected = ry;
+            if (_par[ry].compare_exchange_strong(expected, rx, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return true;
+            }
+            x = rx;
+            y = expected;
+        }
+    }
+
+    bool Same(std::size_t x, std::size_t y)
+    {
+        while (true)
+        {
+            const auto rx = Root(x);
+            const auto ry = Root(y);
+            if (rx == ry)
+            {
+                return true;
+            }
+            // rx がまだ根なら、ry を求めた時点で別の集合だった
+            if (_par[rx].load(std::memory_order_acquire) == rx)
+            {
+                return false;
+            }
+            x = rx;
+            y = ry;
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _par.size();
+    }
+
+private:
+    std::vector<std::atomic<std::size_t>> _par;
+};
@@ -0,0 +1,43 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/all/GRL_1_A"
+
+#include "../graph/shortest_path.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, m, r;
+    cin >> n >> m >> r;
+
+    DenseGraph<size_t, int64_t> graph(false);
+    for (size_t i = 0; i < n; i++)
+    {
+        graph.push_node(i);
+    }
+    for (size_t i = 0; i < m; i++)
+    {
+        size_t s, t;
+        int64_t d;
+        cin >> s >> t >> d;
+        graph.connect(s, t, d);
+    }
+
+    const auto tree = dijkstra<RadixHeapQueue>(graph, r);
+    for (size_t v = 0; v < n; v++)
+    {
+        if (tree.reachable(v))
+        {
+            cout << tree.distance[v] << endl;
+        }
+        else
+        {
+            cout << "INF" << endl;
+        }
+    }
+}
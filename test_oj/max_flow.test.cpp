@@ -0,0 +1,48 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/all/GRL_6_A"
+
+#include "../graph/dinic.hpp"
+#include "../graph/push_relabel.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, m;
+    cin >> n >> m;
+
+    Dinic<int64_t> dinic;
+    PushRelabel<int64_t> fifo(PushRelabelRule::FIFO);
+    PushRelabel<int64_t> highest(PushRelabelRule::HighestLabel);
+    dinic.residual().clear(n);
+    fifo.residual().clear(n);
+    highest.residual().clear(n);
+    for (size_t i = 0; i < m; i++)
+    {
+        size_t u, v;
+        int64_t c;
+        cin >> u >> v >> c;
+        dinic.residual().add_arc(u, v, c);
+        fifo.residual().add_arc(u, v, c);
+        highest.residual().add_arc(u, v, c);
+    }
+    dinic.residual().build();
+    fifo.residual().build();
+    highest.residual().build();
+
+    // 3 つの解が食い違ったら誤答になるように -1 を出す
+    const int64_t flow = dinic.flow(0, n - 1);
+    if (fifo.flow(0, n - 1) != flow || highest.flow(0, n - 1) != flow)
+    {
+        cout << -1 << endl;
+    }
+    else
+    {
+        cout << flow << endl;
+    }
+}
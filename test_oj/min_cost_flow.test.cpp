@@ -0,0 +1,37 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/all/GRL_6_B"
+
+#include "../graph/min_cost_flow.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, m;
+    int64_t f;
+    cin >> n >> m >> f;
+
+    MinCostFlow<int64_t, int64_t> solver(n);
+    for (size_t i = 0; i < m; i++)
+    {
+        size_t u, v;
+        int64_t c, d;
+        cin >> u >> v >> c >> d;
+        solver.add_edge(u, v, c, d);
+    }
+
+    const auto result = solver.flow(0, n - 1, f);
+    if (result.first < f)
+    {
+        cout << -1 << endl;
+    }
+    else
+    {
+        cout << result.second << endl;
+    }
+}
@@ -0,0 +1,32 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/all/GRL_2_A"
+
+#include "../graph/minimum_spanning_tree.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, m;
+    cin >> n >> m;
+
+    DenseGraph<size_t, int64_t> graph(true);
+    for (size_t i = 0; i < n; i++)
+    {
+        graph.push_node(i);
+    }
+    for (size_t i = 0; i < m; i++)
+    {
+        size_t s, t;
+        int64_t w;
+        cin >> s >> t >> w;
+        graph.connect(s, t, w);
+    }
+
+    cout << kruskal(graph).cost << endl;
+}
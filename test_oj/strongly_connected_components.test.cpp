@@ -0,0 +1,36 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/5/GRL/all/GRL_3_C"
+
+#include "../graph/strongly_connected_components.hpp"
+#include "../graph/csr_graph.hpp"
+
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, m;
+    cin >> n >> m;
+
+    CSRGraph<size_t, int>::EdgeListType edges;
+    for (size_t i = 0; i < m; i++)
+    {
+        size_t s, t;
+        cin >> s >> t;
+        edges.emplace_back(s, t, 1);
+    }
+    const CSRGraph<size_t, int> graph(vector<size_t>(n), edges, false);
+    const StronglyConnectedComponents scc(graph);
+
+    size_t q;
+    cin >> q;
+    for (size_t i = 0; i < q; i++)
+    {
+        size_t u, v;
+        cin >> u >> v;
+        cout << (scc.component(u) == scc.component(v) ? 1 : 0) << endl;
+    }
+}
@@ -0,0 +1,32 @@
+#define PROBLEM "https://onlinejudge.u-aizu.ac.jp/courses/library/3/DSL/1/DSL_1_A"
+
+#include "../graph/union_find.hpp"
+
+#include <iostream>
+
+using namespace std;
+
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t n, q;
+    cin >> n >> q;
+
+    CompactUnionFind<> uf(n);
+    for (size_t i = 0; i < q; i++)
+    {
+        int com;
+        size_t x, y;
+        cin >> com >> x >> y;
+        if (com == 0)
+        {
+            uf.Unite(x, y);
+        }
+        else
+        {
+            cout << (uf.Same(x, y) ? 1 : 0) << endl;
+        }
+    }
+}
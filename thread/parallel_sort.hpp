@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @brief [first, last) をスレッドプールで並べ替える (安定ではない)
+ * concurrency() 個の塊をそれぞれ std::sort し、隣り合う塊を 2 つずつ併合する段を log 回繰り返す。
+ * 要素数が少なければ std::sort だけで済ませる。
+ */
+template <typename RandomIt, typename Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+void parallel_sort(RandomIt first, RandomIt last, ThreadPool& pool, Compare comp = Compare())
+{
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const std::size_t chunks = std::min(pool.concurrency(), n / 4096);
+    if (chunks <= 1)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // 塊の境界
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t i = 0; i <= chunks; i++)
+    {
+        bounds[i] = n * i / chunks;
+    }
+    pool.parallel_for(0, chunks, [&](const std::size_t i) {
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+
+    for (std::size_t width = 1; width < chunks; width *= 2)
+    {
+        const std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        pool.parallel_for(0, pairs, [&](const std::size_t i) {
+            const std::size_t begin = 2 * width * i;
+            const std::size_t middle = std::min(begin + width, chunks);
+            const std::size_t end = std::min(begin + 2 * width, chunks);
+            if (middle < end)
+            {
+                std::inplace_merge(first + bounds[begin], first + bounds[middle], first + bounds[end], comp);
+            }
+        });
+    }
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief fork-join 用のスレッドプール
+ * タスクは TaskGroup 単位で待つ。wait() 中の呼び出し側スレッドもキューのタスクを実行するので、
+ * タスクの中から更にタスクを投げて待っても (入れ子の並列化でも) デッドロックしない。
+ */
+class ThreadPool
+{
+public:
+    class TaskGroup
+    {
+    private:
+        friend class ThreadPool;
+        std::size_t pending_ = 0;
+    };
+
+    /**
+     * @param num_threads ワーカースレッド数。呼び出し側も wait 中に働くので、既定はコア数 - 1
+     */
+    explicit ThreadPool(const std::size_t num_threads = default_size())
+    {
+        workers_.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; i++)
+        {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        task_cv_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    static std::size_t default_size()
+    {
+        const std::size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 0 : n - 1;
+    }
+
+    // ワーカースレッド数
+    std::size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    // 呼び出し側を含めて同時に動けるスレッド数
+    std::size_t concurrency() const noexcept
+    {
+        return workers_.size() + 1;
+    }
+
+    void run(TaskGroup& group, std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            group.pending_++;
+            tasks_.emplace_back(std::move(task), &group);
+        }
+        task_cv_.notify_one();
+        done_cv_.notify_one();
+    }
+
+    // group のタスクが全て終わるまで、キューのタスクを実行しながら待つ
+    void wait(TaskGroup& group)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (group.pending_ > 0)
+        {
+            if (!tasks_.empty())
+            {
+                execute_front(lock);
+            }
+            else
+            {
+                done_cv_.wait(lock, [&] { return group.pending_ == 0 || !tasks_.empty(); });
+            }
+        }
+    }
+
+    /**
+     * @brief func(i) を i in [begin, end) について並列に呼び、全て終わるまで待つ
+     * 区間は concurrency() の数倍の塊に分けて投げる。
+     */
+    template <typename Function>
+    void parallel_for(const std::size_t begin, const std::size_t end, Function func)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        const std::size_t chunks = std::min(end - begin, concurrency() * 4);
+        const std::size_t chunk_size = (end - begin + chunks - 1) / chunks;
+
+        TaskGroup group;
+        for (std::size_t first = begin; first < end; first += chunk_size)
+        {
+            const std::size_t last = std::min(first + chunk_size, end);
+            run(group, [first, last, &func] {
+                for (std::size_t i = first; i < last; i++)
+                {
+                    func(i);
+                }
+            });
+        }
+        wait(group);
+    }
+
+private:
+    std::vector<std::thread> workers_;
+
+    std::deque<std::pair<std::function<void()>, TaskGroup*>> tasks_;
+
+    std::mutex mutex_;
+
+    // タスクの追加 / 終了の通知
+    std::condition_variable task_cv_;
+
+    // group の完了 / タスクの追加を wait() に知らせる
+    std::condition_variable done_cv_;
+
+    bool stop_ = false;
+
+    // lock を持った状態で呼ぶ。先頭のタスクを lock を外して実行する
+    void execute_front(std::unique_lock<std::mutex>& lock)
+    {
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task.first();
+        lock.lock();
+        task.second->pending_--;
+        if (task.second->pending_ == 0)
+        {
+            done_cv_.notify_all();
+        }
+    }
+
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            task_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty())
+            {
+                return;
+            }
+            execute_front(lock);
+        }
+    }
+};